@@ -20,6 +20,8 @@ namespace Raster {
         void RenderDetails();
 
         std::optional<Texture> GetPreviewTexture();
+        std::optional<Texture> GetFrameTexture(float t_frame);
+        std::optional<Texture> GetThumbnailTexture();
         void Import(std::string t_path);
 
         std::optional<std::uintmax_t> GetSize();
@@ -28,6 +30,8 @@ namespace Raster {
         std::optional<std::string> GetPath();
 
         bool IsReady();
+        // true while a requested texture is still being copied, decoded or uploaded and an older one (or none) is served instead
+        bool IsLoading();
 
         void Delete();
 
@@ -36,8 +40,13 @@ namespace Raster {
     private:
 
         virtual bool AbstractIsReady() { return true; }
+        virtual bool AbstractIsLoading() { return false; }
 
         virtual std::optional<Texture> AbstractGetPreviewTexture() { return std::nullopt; }
+        // assets without a notion of time simply return their preview texture
+        virtual std::optional<Texture> AbstractGetFrameTexture(float t_frame) { return AbstractGetPreviewTexture(); }
+        // small texture used for browsing, should avoid loading the asset at full resolution
+        virtual std::optional<Texture> AbstractGetThumbnailTexture() { return AbstractGetPreviewTexture(); }
         virtual void AbstractImport(std::string t_path) {}
 
         virtual std::optional<std::string> AbstractGetResolution() { return std::nullopt; }
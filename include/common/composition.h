@@ -13,6 +13,9 @@ namespace Raster {
         std::vector<AbstractAttribute> attributes;
         float beginFrame, endFrame;
         std::string blendMode;
+        // blendMode resolved to an index by the compositor, refreshed whenever blendMode changes
+        std::string cachedBlendMode;
+        int cachedBlendModeIndex;
         float opacity;
         int opacityAttributeID;
         bool enabled;
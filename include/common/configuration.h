@@ -5,6 +5,8 @@
 namespace Raster {
     struct Configuration {
         std::string localizationCode;
+        // megabytes of video memory evictable asset textures are kept within, 0 disables eviction
+        int vramBudget;
 
         Configuration(Json data);
         Configuration();
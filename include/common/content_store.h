@@ -0,0 +1,57 @@
+#pragma once
+
+#include "raster.h"
+#include <mutex>
+#include <atomic>
+
+namespace Raster {
+
+    enum class ContentImportStage {
+        // Copying is only entered when the filesystem can't reflink, the store then pays for one full copy of the source
+        Hashing, Copying, Linking, Finished, Failed
+    };
+
+    struct ContentImportProgress {
+        std::atomic<std::uintmax_t> processedBytes;
+        std::atomic<std::uintmax_t> totalBytes;
+        std::atomic<ContentImportStage> stage;
+
+        ContentImportProgress();
+
+        float GetPercentage();
+    };
+
+    // Deduplicates imported files by content. Every unique file is kept once in
+    // the store and projects receive a reflink, a hardlink or (as the last resort) a copy of it.
+    // The store remembers which project files were placed from every object and removes objects nobody uses anymore
+    struct ContentStore {
+    public:
+        // content hash of the file, cached by path, size and modification time
+        static std::optional<std::string> HashFile(std::string t_path, std::shared_ptr<ContentImportProgress> t_progress = nullptr);
+
+        // places the content of t_sourcePath at t_destinationPath, returns false if nothing could be placed
+        static bool Import(std::string t_sourcePath, std::string t_destinationPath, std::shared_ptr<ContentImportProgress> t_progress = nullptr);
+
+        // tries reflink, then hardlink, then falls back to a regular copy
+        static bool LinkOrCopy(std::string t_sourcePath, std::string t_destinationPath);
+
+        // forgets a project file placed by Import(), the caller removes the file itself
+        static void Release(std::string t_destinationPath);
+        // removes objects whose project files are all gone, e.g. after projects were deleted.
+        // Objects imported before references were tracked are kept
+        static void CollectGarbage();
+
+        static std::string s_storeDirectory;
+
+    private:
+        static std::string GetIndexKey(std::string t_path);
+        static void LoadIndex();
+        static void SaveIndex();
+        static void CollectObject(std::string t_object);
+
+        static bool TryReflink(std::string t_sourcePath, std::string t_destinationPath);
+
+        static std::mutex m_indexMutex;
+        static std::optional<Json> m_index;
+    };
+};
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace Raster {
         static OverlayDispatchersCollection s_overlayDispatchers;
 
         static bool s_enableOverlays;
+        // attachment shown by the framebuffer preview, anything past the color one has to be requested from the compositor
+        static int s_previewAttachment;
 
         static void DispatchProperty(NodeBase* t_owner, std::string t_attrbute, std::any& t_value, bool t_isAttributeExposed);
         static void DispatchString(std::any& t_attribute);
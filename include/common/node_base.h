@@ -46,6 +46,11 @@ namespace Raster {
         std::string libraryName;
         std::string overridenHeader;
         bool enabled, bypassed;
+        // fraction of the required resolution the node renders at (1, 1/2 or 1/4), consumers upsample its output when sampling it
+        float resolutionScale;
+
+        // resolutionScale of the node being executed, Compositor::GetRequiredResolution() is multiplied by it
+        static float s_executionResolutionScale;
 
         void SetAttributeValue(std::string t_attribute, std::any t_value);
 
@@ -111,6 +116,9 @@ namespace Raster {
         std::vector<std::string> m_attributesOrder;
 
         AbstractPinMap m_accumulator;
+
+        // AbstractExecute() with s_executionResolutionScale set to the scale of this node
+        AbstractPinMap ScaledAbstractExecute(AbstractPinMap t_accumulator = {});
     };
 
     using AbstractNode = std::shared_ptr<NodeBase>;
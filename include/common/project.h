@@ -14,6 +14,10 @@ namespace Raster {
 
         glm::vec2 preferredResolution;
         glm::vec4 backgroundColor;
+
+        // normalized (x, y, width, height) part of the frame covered by the framebuffers being rendered,
+        // set only while rendering tiles, never serialized
+        std::optional<glm::vec4> renderRegion;
         
         std::vector<Composition> compositions;
         std::vector<AbstractAsset> assets;
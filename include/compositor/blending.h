@@ -3,6 +3,7 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 
 #define RASTER_BLENDING_PLACEHOLDER "__GENERATED_CODE_GOES_HERE__"
 #define RASTER_BLENDING_FUNCTIONS_PLACEHOLDER "__GENERATED_FUNCTIONS_GO_HERE__"
@@ -19,7 +20,10 @@ namespace Raster {
 
     struct Blending {
         std::vector<BlendingMode> modes;
-        std::optional<Pipeline> pipelineCandidate;
+        // one specialized program per mode index, every mode is queued for background compilation up front
+        std::unordered_map<int, PendingPipeline> pipelines;
+        std::optional<ShaderRequest> vertexShaderCandidate;
+        std::string codeBase;
         std::optional<Framebuffer> framebufferCandidate;
 
         Blending();
@@ -28,7 +32,13 @@ namespace Raster {
         Framebuffer PerformBlending(BlendingMode& mode, Texture base, Texture blend, float opacity);
         Framebuffer PerformManualBlending(BlendingMode& mode, Texture base, Texture blend, float opacity, glm::vec4 backgroundColor);
 
+        // blends color and UV of t_base with the layer straight into t_destination in a single pass
+        void PerformFusedBlending(int t_modeIndex, Framebuffer& t_base, Texture t_blendColor, Texture t_blendUV, float t_opacity, Framebuffer& t_destination);
+
         void GenerateBlendingPipeline();
+        // std::nullopt while the program of the mode is still compiling
+        std::optional<Pipeline> GetModePipeline(int t_modeIndex);
+        void RequestModePipeline(int t_modeIndex);
         void EnsureResolutionConstraints(Texture& texture);
 
         std::optional<int> GetModeIndexByCodeName(std::string t_codename);
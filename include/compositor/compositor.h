@@ -17,23 +17,42 @@ namespace Raster {
     struct CompositorTarget {
         Texture colorAttachment, uvAttachment;
         float opacity;
-        std::string blendMode;
+        // index into Compositor::s_blending.modes, -1 means normal alpha blending
+        int blendModeIndex;
         int compositionID;
+        // Framebuffer::bounds and Framebuffer::opaque of the exported framebuffer
+        std::optional<glm::ivec4> bounds;
+        bool opaque;
+    };
+
+    struct RenderTile {
+        // pixel rectangle (x, y, width, height) of the output covered by the tile framebuffers, guard band included
+        glm::ivec4 region;
+        glm::vec2 outputResolution;
     };
 
     struct Compositor {
         static std::optional<Framebuffer> primaryFramebuffer;
         static float previewResolutionScale;
+        // adaptive preview resolution lowers previewResolutionScale in steps during playback and scrubbing
+        static bool s_adaptiveResolution;
+        static float s_adaptiveResolutionScale;
+        // set while TiledRenderer renders a tile, required resolution then becomes the tile size
+        static std::optional<RenderTile> s_renderTile;
+        // largest sampling radius reported during the frame, in output pixels
+        static glm::vec2 s_samplingRadius;
         static std::unordered_map<int, RenderableBundle> s_bundles;
         static std::vector<CompositorTarget> s_targets;
         static Blending s_blending;
-        static Pipeline s_pipeline;
+        static PendingPipeline s_pipeline;
 
         static void Initialize();
 
         static void ResizePrimaryFramebuffer(glm::vec2 t_resolution);
 
-        static Framebuffer GenerateCompatibleFramebuffer(glm::vec2 t_resolution);
+        static Framebuffer GenerateCompatibleFramebuffer(glm::vec2 t_resolution, TexturePrecision t_precision = TexturePrecision::Usual);
+        // matches t_resolution and carries the UV attachment only while it is required
+        static bool IsCompatibleFramebuffer(Framebuffer& t_fbo, glm::vec2 t_resolution);
 
         static void EnsureResolutionConstraints();
         static void EnsureResolutionConstraintsForFramebuffer(Framebuffer& t_fbo);
@@ -41,6 +60,22 @@ namespace Raster {
         static void PerformManualComposition(std::vector<CompositorTarget> t_targets, Framebuffer& t_fbo, std::optional<glm::vec4> t_backgroundColor = std::nullopt);
         static void PerformComposition(std::vector<int> t_allowedCompositions = {});
 
+        // multiplied by the resolution scale of the node being executed
         static glm::vec2 GetRequiredResolution();
+        // resolution of the whole frame, differs from GetRequiredResolution() only while rendering tiles.
+        // Nodes that measure distances in pixels must scale them by this resolution
+        static glm::vec2 GetOutputResolution();
+        // resolution assets are streamed at: the whole output while rendering tiles for export, the preview otherwise.
+        // Assets are shared between nodes, so node resolution scales are left out
+        static glm::vec2 GetAssetResolution();
+
+        // nodes that read pixels further away than their own call this, tiled rendering sizes its guard band by it
+        static void ReportSamplingRadius(glm::vec2 t_radius);
+
+        // t_cpuTime is the time spent on traversal and composition in milliseconds, GPU time comes from timer queries
+        static void UpdateAdaptiveResolution(float t_cpuTime);
+
+        // resolves the blend mode index once per change of the composition's blend mode
+        static int GetBlendModeIndex(Composition* t_composition);
     };
 };
\ No newline at end of file
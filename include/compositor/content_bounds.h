@@ -0,0 +1,23 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+
+namespace Raster {
+
+    // Helpers for Framebuffer::bounds, rectangles are (x, y, width, height) in pixels
+    // with the origin in the bottom left corner, std::nullopt always means the whole framebuffer
+    struct ContentBounds {
+        static glm::ivec4 Empty();
+        static bool IsEmpty(std::optional<glm::ivec4> t_bounds);
+        static bool CoversFramebuffer(std::optional<glm::ivec4> t_bounds, Framebuffer& t_framebuffer);
+
+        static std::optional<glm::ivec4> Union(std::optional<glm::ivec4> t_a, std::optional<glm::ivec4> t_b);
+        static std::optional<glm::ivec4> Expand(std::optional<glm::ivec4> t_bounds, glm::ivec2 t_padding, Framebuffer& t_framebuffer);
+
+        // screen-space bounds of the [-1, 1] quad transformed by t_matrix
+        static glm::ivec4 FromQuad(glm::mat4 t_matrix, Framebuffer& t_framebuffer);
+
+        static glm::ivec4 Clamp(glm::ivec4 t_bounds, Framebuffer& t_framebuffer);
+    };
+};
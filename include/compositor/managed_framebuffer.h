@@ -5,6 +5,9 @@
 #include "compositor/compositor.h"
 
 namespace Raster {
+    // Thin wrapper around RenderTargetPool, every Get() acquires a fresh transient
+    // target of the required resolution and copies the optional base into it.
+    // The returned target carries the bounds of the base, callers must extend them with RenderTargetPool::SetContentBounds()
     struct ManagedFramebuffer {
     public:
         ManagedFramebuffer();
@@ -14,10 +17,6 @@ namespace Raster {
         void Destroy();
 
     private:
-        void EnsureResolutionConstraints();
-        void InstantiateInternalFramebuffer(uint32_t width, uint32_t height);
-        void DestroyInternalFramebuffer();
-
         Framebuffer m_internalFramebuffer;
     };
 };
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
+
+// deepest level of the downsample chain, the last one is 2^8 times smaller than the source
+#define PYRAMID_BLUR_MAX_LEVELS 8
+
+namespace Raster {
+
+    // Dual Kawase blur. The source is filtered down a chain of pooled half-size targets and back up again,
+    // every pass takes 5 (down) or 8 (up) bilinear taps, so the cost barely depends on the radius
+    struct PyramidBlur {
+        // false while the down- and upsampling pipelines are still compiling
+        static bool IsReady();
+
+        // levels needed for a blur of t_radius pixels, limited by the size of the source
+        static int GetLevels(float t_radius, glm::vec2 t_resolution);
+
+        // downsample chain of t_source, level i is 2^(i + 1) times smaller than the source.
+        // The levels are pool targets with a single attachment, hand them back with Release()
+        static std::vector<Framebuffer> Downsample(Texture& t_source, int t_levels, float t_offset = 1.0f);
+        // upsamples the chain level by level and writes the last step into every pixel of t_target
+        static void Upsample(std::vector<Framebuffer>& t_chain, Framebuffer& t_target, float t_offset = 1.0f);
+        static void Release(std::vector<Framebuffer>& t_chain);
+
+        // blurs t_source with a radius of roughly t_radius pixels into every pixel of t_target
+        static void Blur(Texture& t_source, Framebuffer& t_target, float t_radius);
+
+    private:
+        static void Pass(Pipeline& t_pipeline, Texture& t_source, Framebuffer& t_target, float t_offset);
+
+        static PendingPipeline s_downsamplePipeline, s_upsamplePipeline;
+    };
+};
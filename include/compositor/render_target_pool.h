@@ -0,0 +1,67 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+#include "compositor/compositor.h"
+
+namespace Raster {
+
+    struct RenderTargetPoolEntry {
+        Framebuffer framebuffer;
+        TexturePrecision precision;
+        bool acquired;
+        int unusedFrames;
+        // region the current owner may have written to, std::nullopt means anywhere
+        std::optional<glm::ivec4> writtenBounds;
+        // writtenBounds as it was when the target was acquired last time
+        std::optional<glm::ivec4> previousWrittenBounds;
+    };
+
+    // Per-frame allocator of transient render targets.
+    // Nodes acquire their output targets here instead of owning them, every target
+    // is handed back to the pool when the next frame begins. A node that has finished reading an input
+    // which it does not forward consumes it, so the target can be reused by nodes executed later in the same frame
+    struct RenderTargetPool {
+    public:
+        // compositor compatible target of the required resolution
+        static Framebuffer Acquire();
+        static Framebuffer Acquire(glm::vec2 t_resolution, TexturePrecision t_precision = TexturePrecision::Usual, int t_attachmentsCount = GetCompatibleAttachmentsCount());
+
+        // returns the target immediately, its contents must not be read afterwards
+        static void Release(Framebuffer t_framebuffer);
+
+        // same as Release(), but does nothing while intermediates are being inspected in the UI
+        static void Consume(Framebuffer t_framebuffer);
+        static void Consume(Texture t_texture);
+
+        // must be called by UI code that displays intermediate results, disables aliasing for the next frame
+        static void PreserveIntermediates();
+
+        // must be called by code that reads UV attachments, compositor compatible targets get one in the next frame.
+        // Nothing else consumes them, so they are neither allocated nor written otherwise
+        static void RequireUVAttachments();
+        // color only, or color and UV while UV attachments are required
+        static int GetCompatibleAttachmentsCount();
+
+        // clears the acquired target to transparent black, only the region written by its previous owner is touched
+        static void ClearTarget(Framebuffer& t_framebuffer);
+        // records the content bounds of the target, also narrows the region that ClearTarget() has to clear next time
+        static void SetContentBounds(Framebuffer& t_framebuffer, std::optional<glm::ivec4> t_bounds, bool t_opaque = false);
+
+        static void BeginFrame();
+        static void Clear();
+
+        static int GetAllocatedCount();
+        static int GetAcquiredCount();
+
+    private:
+        static std::optional<RenderTargetPoolEntry*> FindEntry(void* t_colorHandle);
+        static void DestroyEntry(RenderTargetPoolEntry& t_entry);
+
+        static std::vector<RenderTargetPoolEntry> s_entries;
+        static bool s_aliasingAllowed;
+        static bool s_preserveRequested;
+        static bool s_uvAttachmentsRequired;
+        static bool s_uvAttachmentsRequested;
+    };
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+
+// linear taps one pass of shaders/gl/separable_blur/shader.frag can take, two of them are packed into every vec4
+#define SEPARABLE_KERNEL_MAX_TAPS 128
+
+namespace Raster {
+
+    enum class KernelShape {
+        Box, Gaussian
+    };
+
+    // std140 layout of the SeparableKernelTaps block in shaders/gl/separable_blur/shader.frag,
+    // every tap is (offset in pixels along the pass direction, normalized weight)
+    struct SeparableKernelTaps {
+        glm::vec4 taps[SEPARABLE_KERNEL_MAX_TAPS / 2];
+        int count;
+        float padding[3];
+    };
+
+    // 1D kernels applied in one pass per axis. Neighbouring texels are merged into a single
+    // bilinear fetch placed between them, so a kernel covering n texels takes about n / 2 taps
+    struct SeparableKernel {
+        // kernel spanning t_length pixels centered on the output pixel, the gaussian one falls off to 3 sigma at its ends.
+        // Kernels needing more than t_maxTaps taps spread them evenly instead of covering every texel
+        static SeparableKernelTaps Generate(KernelShape t_shape, float t_length, int t_maxTaps);
+
+        // filters t_source along t_direction (normalized) into t_region of t_target (whole target if std::nullopt),
+        // t_pipeline must use separable_blur/shader as its fragment stage
+        static void Apply(Pipeline& t_pipeline, Texture& t_source, Framebuffer& t_target, glm::vec2 t_direction, SeparableKernelTaps& t_taps, std::optional<glm::ivec4> t_region);
+    };
+};
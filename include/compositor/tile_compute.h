@@ -0,0 +1,27 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu/gpu.h"
+
+// threads per workgroup side of every tiled compute shader
+#define TILE_COMPUTE_GROUP_SIZE 16
+// largest apron the shared tile of a workgroup can hold, (16 + 2 * 14)^2 texels packed as half floats fit into the 16 KiB guaranteed by GLES 3.1
+#define TILE_COMPUTE_MAX_APRON 14
+
+namespace Raster {
+
+    // Shared-memory tiled compute passes (shaders/gl/*/shader.compute).
+    // Every workgroup loads its output block together with an apron around it once,
+    // the kernel then reads its samples from shared memory instead of fetching the texture again
+    struct TileCompute {
+        // texels needed on each side of an output pixel by a kernel sampling up to t_extent pixels away from it
+        static glm::ivec2 GetApron(glm::vec2 t_extent);
+
+        // the kernel fits into one tile, the source matches the target texel for texel and the target can be written as an rgba8 image
+        static bool IsApplicable(glm::vec2 t_extent, Texture& t_source, Framebuffer& t_target);
+
+        // runs the bound compute pipeline over t_region of the first attachment (whole target if std::nullopt),
+        // uTexture must already be bound by the caller
+        static void Dispatch(Pipeline& t_pipeline, Framebuffer& t_target, std::optional<glm::ivec4> t_region, glm::ivec2 t_apron);
+    };
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "raster.h"
+#include "common/common.h"
+#include "gpu/gpu.h"
+#include "compositor/compositor.h"
+
+namespace Raster {
+
+    struct TiledRenderRequest {
+        std::string path;
+        glm::ivec2 resolution;
+        // edge length of a tile without its guard band, shrunk when the guard band doesn't fit into GL_MAX_TEXTURE_SIZE
+        int tileSize;
+    };
+
+    // Renders the current frame in tiles and streams them into an image file, so the output
+    // resolution is limited by neither GL_MAX_TEXTURE_SIZE nor VRAM.
+    // Every tile is rendered with a guard band wide enough for the largest sampling radius
+    // reported by the nodes, only the interior of the tile is written out.
+    // Rendering waits for shaders that are still compiling and assets that are still loading at the export resolution,
+    // otherwise layers would be missing or sampled from preview sized mip levels
+    struct TiledRenderer {
+    public:
+        static void Request(TiledRenderRequest t_request);
+
+        // renders the first request synchronously once nothing is pending, must be called outside of traversal and composition
+        static void ProcessRequests();
+
+    private:
+        // traverses a small region at the export resolution, so assets start loading the mip levels the tiles need
+        static bool Prepare(TiledRenderRequest& t_request);
+        static bool IsPending();
+        // t_interrupted is set when something started loading while the tiles were rendered, the request has to be retried
+        static bool Render(TiledRenderRequest& t_request, bool& t_interrupted);
+        static glm::vec2 MeasureSamplingRadius(glm::ivec2 t_resolution, int t_maxTextureSize);
+        static void RenderRegion(glm::ivec4 t_region, glm::ivec2 t_resolution, std::optional<Framebuffer> t_framebuffer);
+
+        static std::vector<TiledRenderRequest> s_requests;
+        static int s_waitedFrames;
+    };
+};
@@ -4,13 +4,17 @@
 #include "common/randomizer.h"
 #include "raster.h"
 #include "image/image.h"
+#include "image/texture_compression.h"
 
 namespace Raster {
 
     struct AsyncUploadInfo {
         Texture texture;
-        Texture deleteTexture;
         std::shared_ptr<Image> image;
+        // uploaded instead of image when set
+        std::shared_ptr<CompressedImage> compressedImage;
+        // memory owner of the requesting thread, the texture is attributed to it instead of the uploader
+        GPUMemoryOwner owner;
         bool ready;
         bool executed;
 
@@ -26,6 +30,7 @@ namespace Raster {
         static void UploaderLogic();
 
         static AsyncUploadInfoID GenerateTextureFromImage(std::shared_ptr<Image> t_image);
+        static AsyncUploadInfoID GenerateTextureFromCompressedImage(std::shared_ptr<CompressedImage> t_image);
         static void DestroyTexture(Texture texture);
 
         static bool IsUploadReady(AsyncUploadInfoID t_id);
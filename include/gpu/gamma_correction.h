@@ -0,0 +1,21 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu.h"
+#include "shader_compiler.h"
+
+namespace Raster {
+
+    // Linear sources (EXR) are brought to the gamma the rest of the editor expects right after their upload,
+    // so every asset that shows them produces the same pixels
+    struct GammaCorrection {
+        // false while the gamma correction program is still compiling
+        static bool IsReady();
+        // rewrites t_texture in place, only call once IsReady() returned true
+        static void Apply(Texture& t_texture, float t_gamma = 2.2f);
+        static bool IsRequired(std::string t_path);
+
+    private:
+        static PendingPipeline s_pipeline;
+    };
+};
\ No newline at end of file
@@ -7,6 +7,8 @@ namespace Raster {
     struct GPUInfo {
         std::string renderer;
         std::string version;
+        // largest width or height of a texture, and therefore of a render target
+        int maxTextureSize;
 
         void* display;
     };
@@ -21,6 +23,11 @@ namespace Raster {
         Vertex, Fragment, Compute
     };
 
+    // how a compute pipeline accesses a texture bound with GPU::BindImageTexture()
+    enum class ImageAccess {
+        Read, Write, ReadWrite
+    };
+
     enum class TextureWrappingAxis {
         S, T
     };
@@ -50,7 +57,11 @@ namespace Raster {
         uint32_t width, height;
         int channels;
         TexturePrecision precision;
+        // ETC2 block compressed, sampled like any other texture but never rendered to or updated
+        bool compressed;
         void* handle;
+        // tells apart reuses of the same GL name, destroying a stale copy after the name was reused is a no-op
+        uint32_t generation;
 
         Texture();
 
@@ -70,6 +81,7 @@ namespace Raster {
         };
 
         std::string GetShortPrecisionInfo() {
+            if (compressed) return channels == 4 ? "ETC2+EAC" : "ETC2";
             switch (channels) {
                 case 1: {
                     if (precision == TexturePrecision::Usual) return "R8";
@@ -105,6 +117,12 @@ namespace Raster {
         std::vector<Texture> attachments;
         void* handle;
         void* depthHandle;
+        // generation of the depth buffer allocation, see Texture::generation
+        uint32_t generation;
+        // conservative pixel rectangle (x, y, width, height) containing every non-empty pixel, std::nullopt means unknown
+        std::optional<glm::ivec4> bounds;
+        // every pixel inside bounds has full alpha
+        bool opaque;
 
         Framebuffer();
     };
@@ -122,6 +140,67 @@ namespace Raster {
         void* handle;
     };
 
+    // uniform location resolved ahead of time, setting it involves no lookups
+    struct UniformHandle {
+        void* shader;
+        int location;
+
+        UniformHandle();
+    };
+
+    // GL calls issued through GPU during one frame, redundant calls skipped by the state shadow are counted separately
+    struct GPUFrameStatistics {
+        int drawCalls;
+        int computeDispatches;
+        int clears;
+        int framebufferBinds;
+        int pipelineBinds;
+        int textureBinds;
+        int samplerBinds;
+        // blending, scissor and viewport changes
+        int stateChanges;
+        int skippedCalls;
+    };
+
+    // GL objects alive on every context, destroyed objects are counted until their deferred destruction runs
+    struct GPUObjectCounters {
+        int textures;
+        int framebuffers;
+        int samplers;
+        int shaders;
+        int pipelines;
+        // textures and framebuffers waiting for the next frame boundary
+        int pendingDestructions;
+    };
+
+    // part of the application video memory is attributed to, allocations made outside of any GPUMemoryOwnerScope count as Other
+    enum class GPUMemoryOwner {
+        Other, Compositor, Node, Asset
+    };
+
+    #define GPU_MEMORY_OWNERS_COUNT 4
+
+    // estimated video memory of live textures and framebuffer depth buffers, in bytes
+    struct GPUMemoryUsage {
+        uint64_t bytes[GPU_MEMORY_OWNERS_COUNT];
+        uint64_t total;
+    };
+
+    // attributes the allocations of the current thread to t_owner until the scope ends
+    struct GPUMemoryOwnerScope {
+        GPUMemoryOwnerScope(GPUMemoryOwner t_owner);
+        ~GPUMemoryOwnerScope();
+
+    private:
+        GPUMemoryOwner m_previousOwner;
+    };
+
+    // range of the shared uniform buffer ring holding one uploaded uniform block
+    struct UniformBlock {
+        void* buffer;
+        uint32_t offset, size;
+    };
+
     struct GPU {
         static GPUInfo info;
         static Shader s_basicShader;
@@ -136,11 +215,31 @@ namespace Raster {
 
         static void Flush();
 
+        // GPU time measurement through EXT_disjoint_timer_query, queries are read back a few frames later to avoid stalls
+        static bool IsTimerQuerySupported();
+        static void BeginTimerQuery();
+        static void EndTimerQuery();
+        // milliseconds spent by the GPU between the last resolved Begin/EndTimerQuery() pair
+        static std::optional<float> GetLastTimerQueryResult();
+
+        // counters of the previous frame
+        static GPUFrameStatistics GetFrameStatistics();
+        static GPUObjectCounters GetObjectCounters();
+        static GPUMemoryUsage GetMemoryUsage();
+        // owner new allocations of the current thread are attributed to
+        static GPUMemoryOwner GetMemoryOwner();
+        static uint64_t GetTextureMemory(Texture texture);
+
         static Texture ImportTexture(const char* path);
         static Texture GenerateTexture(uint32_t width, uint32_t height, int channels, TexturePrecision precision = TexturePrecision::Usual);
+        // immutable texture from ETC2 RGB8 (3 channels) or ETC2 RGBA8 (4 channels) blocks
+        static Texture GenerateCompressedTexture(uint32_t width, uint32_t height, int channels, const void* data, size_t size);
         static void UpdateTexture(Texture texture, uint32_t x, uint32_t y, uint32_t w, uint32_t h, int channels, void* pixels);
+        // Textures and framebuffers are copied freely, so their destruction is queued and executed by the main context
+        // when the next frame begins. Copies stay valid until then, destroying the same object twice before that is harmless
         static void DestroyTexture(Texture texture);
-        static void BindTextureToShader(Shader shader, std::string name, Texture texture, int unit);
+        static void BindTextureToShader(Shader shader, const std::string& name, Texture texture, int unit);
+        static void BindTextureToShader(UniformHandle handle, Texture texture, int unit);
         static void BlitTexture(Texture base, Texture blit);
 
         static Framebuffer GenerateFramebuffer(uint32_t width, uint32_t height, std::vector<Texture> attachments);
@@ -148,26 +247,59 @@ namespace Raster {
         static void DestroyFramebufferWithAttachments(Framebuffer fbo);
 
         static Shader GenerateShader(ShaderType type, std::string name, bool useBinaryCache = true);
+        // compiles code that never touches the shaders directory, the binary cache is keyed by the source itself
+        // and the driver identity, name is only used in diagnostics
+        static Shader GenerateShaderFromSource(ShaderType type, std::string code);
+        static Shader GenerateShaderFromSource(ShaderType type, std::string name, std::string code, bool useBinaryCache = true);
 
-        // TODO: Implement compute pipeline
         static Pipeline GeneratePipeline(Shader vertexShader, Shader fragmentShader);
+        static Pipeline GenerateComputePipeline(Shader computeShader);
         static void BindPipeline(Pipeline pipeline);
 
-        static int GetShaderUniformLocation(Shader shader, std::string name);
+        static int GetShaderUniformLocation(Shader shader, const std::string& name);
+        static UniformHandle GetUniformHandle(Shader shader, const std::string& name);
+
+        static void SetShaderUniform(Shader shader, const std::string& name, int i);
+        static void SetShaderUniform(Shader shader, const std::string& name, glm::vec4 vec);
+        static void SetShaderUniform(Shader shader, const std::string& name, glm::vec2 vec);
+        static void SetShaderUniform(Shader shader, const std::string& name, float f);
+        static void SetShaderUniform(Shader shader, const std::string& name, glm::mat4 mat);
 
-        static void SetShaderUniform(Shader shader, std::string name, int i);
-        static void SetShaderUniform(Shader shader, std::string name, glm::vec4 vec);
-        static void SetShaderUniform(Shader shader, std::string name, glm::vec2 vec);
-        static void SetShaderUniform(Shader shader, std::string name, float f);
-        static void SetShaderUniform(Shader shader, std::string name, glm::mat4 mat);
+        static void SetShaderUniform(UniformHandle handle, int i);
+        static void SetShaderUniform(UniformHandle handle, glm::vec4 vec);
+        static void SetShaderUniform(UniformHandle handle, glm::vec2 vec);
+        static void SetShaderUniform(UniformHandle handle, float f);
+        static void SetShaderUniform(UniformHandle handle, glm::mat4 mat);
+
+        // copies a std140 block into the uniform buffer ring, bind the returned range with BindUniformBlock()
+        static UniformBlock UploadUniformBlock(const void* data, uint32_t size);
+        // binds the range to the block declared with layout(binding = binding)
+        static void BindUniformBlock(UniformBlock block, int binding);
 
         static void DrawArrays(int count);
+
+        // binds level 0 of the texture to an image unit, the image format follows the precision of the texture
+        static void BindImageTexture(Texture texture, int unit, ImageAccess access);
+        // runs the bound compute pipeline, its image writes are visible to every later texture fetch and framebuffer operation
+        static void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ = 1);
+
+        // fixed-function alpha blending is enabled by default, passes that overwrite their target disable it
+        static void SetBlendingEnabled(bool enabled);
         
         static void BindFramebuffer(std::optional<Framebuffer> fbo);
         static void ClearFramebuffer(float r, float g, float b, float a);
-        static void BlitFramebuffer(Framebuffer target, Texture texture, int attachment = 0);
+        static void BlitFramebuffer(Framebuffer target, Texture texture, int attachment = 0, std::optional<glm::ivec4> region = std::nullopt);
+        // copies an attachment of a framebuffer of another size into the same attachment of target, filtered linearly
+        static void ResampleFramebuffer(Framebuffer target, Framebuffer source, int attachment = 0);
+        // restricts clears and draws to the pixel rectangle, std::nullopt disables the scissor test
+        static void SetScissor(std::optional<glm::ivec4> rect);
+        // reads an RGBA8 rectangle of the attachment into pixels, rows are tightly packed
+        // Usual precision reads RGBA8, the others RGBA 32-bit floats
+        static void ReadPixels(Framebuffer fbo, int attachment, glm::ivec4 rect, void* pixels, TexturePrecision precision = TexturePrecision::Usual);
 
         static Sampler GenerateSampler(); 
+        // immutable sampler shared by every caller asking for the same state, owned by the GPU layer and never destroyed by its users
+        static Sampler GetSampler(TextureWrappingMode wrapping, TextureFilteringMode filtering);
         static void BindSampler(std::optional<Sampler> sampler, int unit = 0);
         static void SetSamplerTextureFilteringMode(Sampler& sampler, TextureFilteringOperation operation, TextureFilteringMode mode);
         static void SetSamplerTextureWrappingMode(Sampler& sampler, TextureWrappingAxis axis, TextureWrappingMode mode);
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu.h"
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+namespace Raster {
+
+    // program which may still be compiling. Owned requests belong to the caller,
+    // shared ones are cached by ShaderCompiler and must never be destroyed by their users
+    struct ShaderRequest {
+        std::shared_future<Shader> shader;
+        bool owned;
+
+        ShaderRequest();
+        ShaderRequest(std::shared_future<Shader> t_shader, bool t_owned);
+    };
+
+    // pipeline assembled from a vertex and a fragment request, or from a single compute request. Get() never blocks,
+    // callers skip drawing for the frame while it returns std::nullopt
+    struct PendingPipeline {
+    public:
+        PendingPipeline();
+        PendingPipeline(ShaderRequest t_vertex, ShaderRequest t_fragment);
+        PendingPipeline(ShaderRequest t_compute);
+
+        bool IsRequested();
+        std::optional<Pipeline> Get();
+
+        // releases the pipeline and its owned programs, programs that are still compiling are released once they finish
+        void Destroy();
+
+    private:
+        std::optional<ShaderRequest> m_vertex, m_fragment, m_compute;
+        std::optional<Pipeline> m_pipeline;
+        bool m_failed;
+    };
+
+    // Compiles programs on background contexts sharing objects with the main one.
+    // Program pipeline objects are not shared between contexts, so pipelines are assembled
+    // on the main thread as soon as both of their programs are ready
+    struct ShaderCompiler {
+    public:
+        static void Initialize();
+        static void Terminate();
+
+        // queues every complete program of the shaders directory, so nodes created later find them already compiled.
+        // Complete programs are the vertex shaders and the fragment and compute shaders named shader.*, the rest are templates
+        static void WarmUp();
+
+        // shared, every request of the same file returns the same program
+        static ShaderRequest RequestShader(ShaderType t_type, std::string t_name);
+        // owned, name is only used in diagnostics
+        static ShaderRequest RequestShaderFromSource(ShaderType t_type, std::string t_name, std::string t_code);
+        // wraps a program compiled synchronously, e.g. GPU::s_basicShader
+        static ShaderRequest Ready(Shader t_shader);
+
+        static PendingPipeline RequestPipeline(ShaderRequest t_vertex, ShaderRequest t_fragment);
+        static PendingPipeline RequestComputePipeline(ShaderRequest t_compute);
+
+        static int GetPendingCount();
+
+    private:
+        friend struct PendingPipeline;
+
+        static ShaderRequest Enqueue(std::function<Shader()> t_compile, bool t_owned);
+        static void WorkerLogic(void* t_context);
+
+        // owned programs whose pipelines were destroyed before they finished compiling
+        static void Discard(std::shared_future<Shader> t_shader);
+        static void CollectDiscarded();
+
+        static bool s_running;
+        static std::mutex s_tasksMutex;
+        static std::condition_variable s_tasksCondition;
+        static std::deque<std::function<void()>> s_tasks;
+        static std::vector<std::thread> s_workers;
+        static std::atomic<int> s_pendingCount;
+
+        static std::unordered_map<std::string, ShaderRequest> s_sharedShaders;
+        static std::vector<std::shared_future<Shader>> s_discarded;
+    };
+};
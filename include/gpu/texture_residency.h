@@ -0,0 +1,47 @@
+#pragma once
+
+#include "raster.h"
+#include "gpu.h"
+#include <mutex>
+
+// frames an evictable texture stays protected after its last use, roughly two seconds of playback
+#define TEXTURE_RESIDENCY_PROTECTED_FRAMES 120
+
+namespace Raster {
+
+    using TextureResidencyID = int;
+
+    struct TextureResidencyEntry {
+        Texture texture;
+        uint64_t lastUsedFrame;
+    };
+
+    // Textures their owners can load again on demand, e.g. decoded asset images. While the video memory reported by
+    // GPU::GetMemoryUsage() exceeds the budget, the least recently used ones outside of the protection window are destroyed.
+    // Owners call Touch() whenever they hand the texture out and drop their copy once it returns false
+    struct TextureResidency {
+    public:
+        // bytes, 0 disables eviction
+        static uint64_t s_budget;
+
+        static TextureResidencyID Register(Texture t_texture);
+        // forgets the entry without destroying the texture, the owner destroys it itself
+        static void Unregister(TextureResidencyID& t_id);
+        // false once the texture was evicted, the entry is forgotten by then
+        static bool Touch(TextureResidencyID t_id);
+
+        // evicts textures until the budget is met, must be called by the main thread once per frame
+        static void BeginFrame();
+
+        static int GetResidentCount();
+        static uint64_t GetResidentMemory();
+        static int GetEvictedCount();
+
+    private:
+        static std::mutex s_mutex;
+        static std::unordered_map<TextureResidencyID, TextureResidencyEntry> s_entries;
+        static TextureResidencyID s_nextID;
+        static uint64_t s_frame;
+        static int s_evictedCount;
+    };
+};
\ No newline at end of file
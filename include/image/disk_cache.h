@@ -0,0 +1,56 @@
+#pragma once
+
+#include "raster.h"
+#include "image/image.h"
+
+namespace Raster {
+
+    // Read-only memory mapping of a cached image file
+    struct MappedImageFile {
+    public:
+        MappedImageFile(std::string t_path);
+        ~MappedImageFile();
+
+        MappedImageFile(const MappedImageFile&) = delete;
+        MappedImageFile& operator=(const MappedImageFile&) = delete;
+
+        bool IsValid();
+
+        uint8_t* data;
+        size_t size;
+
+    private:
+#ifdef _WIN32
+        void* m_fileHandle;
+        void* m_mappingHandle;
+#else
+        int m_fileDescriptor;
+#endif
+    };
+
+    // Stores decoded pixels of expensive images in a raw, memory-mappable layout
+    // keyed by the content hash of the source file and the loader options
+    struct ImageDiskCache {
+    public:
+        static std::optional<std::string> GetKey(std::string t_path, ImageLoaderOptions t_options);
+
+        static std::optional<Image> Load(std::string t_key);
+        static void Store(std::string t_key, Image& t_image);
+
+        // removes least recently used entries until the cache fits into the budget
+        static void Trim();
+
+        // raw layout used by cache entries, also usable for any other small image stored on disk
+        static std::optional<Image> ReadRawImage(std::string t_path);
+        static bool WriteRawImage(std::string t_path, Image& t_image);
+
+        static std::string s_cacheDirectory;
+        static std::uintmax_t s_budget;
+
+    private:
+        static std::string GetEntryPath(std::string t_key);
+        static void TrimUnlocked();
+
+        static std::mutex m_cacheMutex;
+    };
+};
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include "raster.h"
 #include "common/common.h"
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
 
 namespace Raster {
     enum class ImagePrecision {
@@ -10,35 +14,100 @@ namespace Raster {
         Full // RGBA32F
     };
 
+    struct MappedImageFile;
+
     struct Image {
     public:
         ImagePrecision precision;
         std::vector<uint8_t> data;
+
+        // images restored from the disk cache point into a mapped file instead of owning their pixels
+        std::shared_ptr<MappedImageFile> mapping;
+        size_t mappingOffset;
+        size_t mappingSize;
+
         uint32_t width; uint32_t height;
         int channels;
 
+        // resolution of the source file, differs from width/height when a lower mip level was loaded
+        uint32_t originalWidth; uint32_t originalHeight;
+
         Image();
+
+        uint8_t* GetData();
+        size_t GetDataSize();
+    };
+
+    struct ImageLoaderOptions {
+        // when set, the image is read through the shared image cache using
+        // the smallest mip level that still covers this resolution
+        std::optional<glm::vec2> targetResolution;
+
+        // subimage (EXR part) to read from
+        int part;
+        // when set, only the channels of this layer are read ("" is the unnamed RGBA layer)
+        std::optional<std::string> layer;
+
+        // check the decoded-image disk cache before decoding and store slow decodes in it
+        bool useDiskCache;
+
+        ImageLoaderOptions();
+    };
+
+    struct ImagePartInfo {
+        int index;
+        std::string name;
+        int channels;
+        std::vector<std::string> layers;
     };
 
     struct ImageLoader {
     public:
-        static std::optional<Image> Load(std::string t_path);
+        static std::optional<Image> Load(std::string t_path, ImageLoaderOptions t_options = ImageLoaderOptions());
+
+        // reads only headers, lists every part of the file together with its channel layers
+        static std::vector<ImagePartInfo> GetParts(std::string t_path);
+
+        // box-filters the image down to fit t_maxSize and converts it to 8-bit display values
+        static Image GenerateThumbnail(Image& t_image, uint32_t t_maxSize);
 
         static std::string GetImplementationName();
         static std::vector<std::string> GetSupportedExtensions();
+
+    private:
+        static std::optional<Image> LoadFromImageCache(std::string t_path, ImageLoaderOptions t_options);
+    };
+
+    using ImageDecodeResult = std::optional<std::shared_ptr<Image>>;
+
+    // Fixed set of worker threads shared by every asynchronous image decode
+    struct ImageDecodePool {
+    public:
+        static std::future<ImageDecodeResult> Decode(std::string t_path, ImageLoaderOptions t_options = ImageLoaderOptions());
+        static int GetPendingCount();
+
+    private:
+        static void WorkerLogic();
+        static void EnsureWorkers();
+
+        static std::mutex m_queueMutex;
+        static std::condition_variable m_queueCondition;
+        static std::deque<std::packaged_task<ImageDecodeResult()>> m_queue;
+        static std::vector<std::thread> m_workers;
+        static std::atomic<int> m_pendingCount;
     };
 
     struct AsyncImageLoader {
     public:
         AsyncImageLoader();
-        AsyncImageLoader(std::string t_path);
+        AsyncImageLoader(std::string t_path, ImageLoaderOptions t_options = ImageLoaderOptions());
 
         bool IsReady();
         bool IsInitialized();
-        std::optional<std::shared_ptr<Image>> Get();
+        ImageDecodeResult Get();
 
     private:
-        std::future<std::optional<std::shared_ptr<Image>>> m_future;
+        std::future<ImageDecodeResult> m_future;
         bool m_initialized;
     };
 };
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "raster.h"
+#include "image/image.h"
+
+namespace Raster {
+
+    enum class TextureCompressionQuality {
+        Fast, Balanced, High
+    };
+
+    // block compressed pixels ready for GPU::GenerateCompressedTexture(), blocks are stored row by row like uncompressed pixels
+    struct CompressedImage {
+        uint32_t width, height;
+        uint32_t originalWidth, originalHeight;
+        // 3 for ETC2 RGB8 (8 bytes per 4x4 block), 4 for ETC2 RGBA8 with EAC alpha (16 bytes per block)
+        int channels;
+        std::vector<uint8_t> data;
+    };
+
+    // ETC2 / EAC encoder. Both formats are core in GLES 3.0, so every driver samples them natively at 4 or 8 bits per pixel
+    struct TextureCompression {
+        // only 8-bit images with 3 or 4 channels are compressed, higher precisions and masks are left untouched
+        static bool IsCompressible(Image& t_image);
+        // encodes blocks on several threads, slower qualities search more base colors per block
+        static std::optional<CompressedImage> Compress(Image& t_image, TextureCompressionQuality t_quality);
+
+        static std::optional<CompressedImage> Read(std::string t_path);
+        static bool Write(std::string t_path, CompressedImage& t_image);
+    };
+};
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "raster.h"
+#include "image/image.h"
+
+namespace Raster {
+
+    struct TiledImageWriterState;
+
+    // Streams an image to disk tile by tile.
+    // Formats with native tiles (TIFF, EXR) keep only the tile being written in memory,
+    // other formats buffer one row of tiles and write it as scanlines
+    struct TiledImageWriter {
+    public:
+        TiledImageWriter();
+
+        // formats that keep values outside of 0..1 (OpenEXR), written as half floats instead of 8 bits
+        static bool IsHighPrecisionFormat(std::string t_path);
+
+        // tiles of high precision formats are passed as 32-bit floats, all others as 8-bit
+        bool Open(std::string t_path, uint32_t t_width, uint32_t t_height, uint32_t t_tileSize);
+        // t_x and t_y are multiples of the tile size measured from the top left corner, tiles must arrive in row-major order.
+        // t_tile holds RGBA pixels of the precision expected by Open() and may be smaller than the tile size at the right and bottom edges
+        bool WriteTile(uint32_t t_x, uint32_t t_y, Image& t_tile);
+        bool Close();
+
+        bool IsOpen();
+
+    private:
+        std::shared_ptr<TiledImageWriterState> m_state;
+    };
+};
@@ -8,20 +8,21 @@ precision highp float;
 #define b blend
 
 layout(location = 0) out vec4 gColor;
+layout(location = 1) out vec4 gUV;
 
 uniform vec2 uResolution;
 
 uniform sampler2D uBase;
 uniform sampler2D uBlend;
+uniform sampler2D uBaseUV;
+uniform sampler2D uBlendUV;
 
 uniform float uOpacity;
-uniform int uBlendMode;
 
 __GENERATED_FUNCTIONS_GO_HERE__
 
 vec3 blendMaster(vec3 base, vec3 blend, float opacity) {
     __GENERATED_CODE_GOES_HERE__
-    return mix(base, blend, opacity);
 }
 
 void main() {
@@ -34,4 +35,5 @@ void main() {
     } else {
         gColor = baseTexel;
     }
+    gUV = blendTexel.w != 0.0 ? texture(uBlendUV, uv) : texture(uBaseUV, uv);
 }
\ No newline at end of file
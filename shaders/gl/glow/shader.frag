@@ -0,0 +1,41 @@
+#version 310 es
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+layout(location = 0) out vec4 gColor;
+
+uniform int uStage;
+uniform vec2 uResolution;
+
+uniform sampler2D uTexture;
+uniform sampler2D uGlow;
+
+uniform float uThreshold;
+uniform float uSoftness;
+
+uniform float uIntensity;
+uniform vec4 uColor;
+
+// parts brighter than the threshold, the knee around it fades them in smoothly
+vec4 ExtractBright(vec4 color) {
+    float brightness = max(color.r, max(color.g, color.b)) * color.a;
+    float knee = uThreshold * uSoftness + 0.0001;
+    float soft = clamp(brightness - uThreshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee);
+    float contribution = max(soft, brightness - uThreshold) / max(brightness, 0.0001);
+    return vec4(color.rgb * color.a, color.a) * contribution;
+}
+
+void main() {
+    vec2 uv = gl_FragCoord.xy / uResolution;
+    if (uStage == 0) {
+        gColor = ExtractBright(texture(uTexture, uv));
+    } else {
+        vec4 base = texture(uTexture, uv);
+        vec3 glow = texture(uGlow, uv).rgb * uColor.rgb * uColor.a * uIntensity;
+        float glowAlpha = clamp(max(glow.r, max(glow.g, glow.b)), 0.0, 1.0);
+        gColor = vec4(base.rgb + glow, max(base.a, glowAlpha));
+    }
+}
\ No newline at end of file
@@ -21,6 +21,7 @@ uniform int uIterations;
 uniform vec2 uHashOffset;
 
 uniform vec2 uResolution;
+// prefiltered by HashedBlur when the taps lie further apart than a texel
 uniform sampler2D uTexture;
 
 uniform float uRadius;
@@ -57,7 +58,7 @@ vec3 Blur(vec2 uv, float radius)
 	vec3 acc = vec3(0.0);
 	for (int i = 0; i < uIterations; i++)
     {
-		acc += texture(uTexture, uv + circle * Sample(random), radius*10.0).xyz;
+		acc += texture(uTexture, uv + circle * Sample(random)).xyz;
     }
 	return acc / float(uIterations);
 }
@@ -9,20 +9,20 @@ layout(location = 1) out vec4 gUV;
 
 in vec2 vUV;
 
-uniform vec4 uColor;
+// uploaded at once by Layer2D, must match Layer2DParameters
+layout(std140, binding = 0) uniform Layer2DParameters {
+    vec4 uColor;
+    vec2 uUVPosition;
+    vec2 uUVSize;
+    float uUVAngle;
+    float uAspectRatio;
+    bool uTextureAvailable;
+    bool uMaintainUVRange;
+    bool uAspectRatioCorrection;
+};
 
-uniform bool uTextureAvailable;
 uniform sampler2D uTexture;
 
-uniform vec2 uUVPosition;
-uniform vec2 uUVSize;
-uniform float uUVAngle;
-
-uniform bool uMaintainUVRange;
-
-uniform float uAspectRatio;
-uniform bool uAspectRatioCorrection;
-
 SDF_UNIFORMS_PLACEHOLDER
 
 float saturateUV(float a) {
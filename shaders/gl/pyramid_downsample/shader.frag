@@ -0,0 +1,31 @@
+#version 310 es
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// Downsampling step of the dual Kawase blur, see PyramidBlur in include/compositor/pyramid_blur.h
+// Based on "Bandwidth-Efficient Rendering" by Marius Bjorge (SIGGRAPH 2015)
+
+
+layout(location = 0) out vec4 gColor;
+
+// resolution of the target, the source is twice as large
+uniform vec2 uResolution;
+uniform float uOffset;
+
+uniform sampler2D uTexture;
+
+void main() {
+    vec2 uv = gl_FragCoord.xy / uResolution;
+    // half a target pixel is one source texel
+    vec2 halfPixel = 0.5 / uResolution * uOffset;
+
+    vec4 total = texture(uTexture, uv) * 4.0;
+    total += texture(uTexture, uv - halfPixel);
+    total += texture(uTexture, uv + halfPixel);
+    total += texture(uTexture, uv + vec2(halfPixel.x, -halfPixel.y));
+    total += texture(uTexture, uv - vec2(halfPixel.x, -halfPixel.y));
+
+    gColor = total / 8.0;
+}
\ No newline at end of file
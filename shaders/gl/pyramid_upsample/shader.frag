@@ -0,0 +1,34 @@
+#version 310 es
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// Upsampling step of the dual Kawase blur, see PyramidBlur in include/compositor/pyramid_blur.h
+// Based on "Bandwidth-Efficient Rendering" by Marius Bjorge (SIGGRAPH 2015)
+
+
+layout(location = 0) out vec4 gColor;
+
+// resolution of the target, the source is half as large
+uniform vec2 uResolution;
+uniform float uOffset;
+
+uniform sampler2D uTexture;
+
+void main() {
+    vec2 uv = gl_FragCoord.xy / uResolution;
+    // one target pixel is half a source texel
+    vec2 halfPixel = 1.0 / uResolution * uOffset;
+
+    vec4 total = texture(uTexture, uv + vec2(-halfPixel.x * 2.0, 0.0));
+    total += texture(uTexture, uv + vec2(-halfPixel.x, halfPixel.y)) * 2.0;
+    total += texture(uTexture, uv + vec2(0.0, halfPixel.y * 2.0));
+    total += texture(uTexture, uv + vec2(halfPixel.x, halfPixel.y)) * 2.0;
+    total += texture(uTexture, uv + vec2(halfPixel.x * 2.0, 0.0));
+    total += texture(uTexture, uv + vec2(halfPixel.x, -halfPixel.y)) * 2.0;
+    total += texture(uTexture, uv + vec2(0.0, -halfPixel.y * 2.0));
+    total += texture(uTexture, uv + vec2(-halfPixel.x, -halfPixel.y)) * 2.0;
+
+    gColor = total / 12.0;
+}
\ No newline at end of file
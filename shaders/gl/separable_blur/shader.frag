@@ -0,0 +1,37 @@
+#version 310 es
+
+#ifdef GL_ES
+precision highp float;
+#endif
+
+// One pass of a separable kernel, see SeparableKernel in include/compositor/separable_kernel.h.
+// Every tap is a bilinear fetch between two texels carrying the weights of both of them
+
+
+layout(location = 0) out vec4 gColor;
+
+#define MAX_TAPS 128
+
+layout(std140, binding = 0) uniform SeparableKernelTaps {
+    vec4 uTaps[MAX_TAPS / 2];
+    int uTapsCount;
+};
+
+uniform vec2 uResolution;
+uniform vec2 uDirection;
+
+uniform sampler2D uTexture;
+
+void main() {
+    vec2 uv = gl_FragCoord.xy / uResolution;
+    vec2 step = uDirection / uResolution;
+
+    vec4 total = vec4(0);
+    for (int i = 0; i < uTapsCount; i++) {
+        vec4 packedTaps = uTaps[i / 2];
+        vec2 tap = (i % 2 == 0) ? packedTaps.xy : packedTaps.zw;
+        total += texture(uTexture, uv + tap.x * step) * tap.y;
+    }
+
+    gColor = total;
+}
\ No newline at end of file
@@ -1,12 +1,17 @@
 #include "app/app.h"
 #include "gpu/gpu.h"
 #include "gpu/async_upload.h"
+#include "gpu/shader_compiler.h"
+#include "gpu/texture_residency.h"
 #include "font/font.h"
 #include "common/common.h"
+#include "common/content_store.h"
 #include "traverser/traverser.h"
 #include "build_number.h"
 #include "common/ui_shared.h"
 #include "compositor/compositor.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/tiled_renderer.h"
 #include "node_category/node_category.h"
 #include "dispatchers_installer/dispatchers_installer.h"
 #include "../ImGui/imgui.h"
@@ -29,9 +34,13 @@ namespace Raster {
 
         GPU::Initialize();
         AsyncUpload::Initialize();
+        ShaderCompiler::Initialize();
+        // programs compile in the background while the rest of the editor boots up
+        ShaderCompiler::WarmUp();
         ImGui::SetCurrentContext((ImGuiContext*) GPU::GetImGuiContext());
 
         Workspace::s_configuration = Configuration(ReadJson("misc/config.json"));
+        TextureResidency::s_budget = (uint64_t) std::max(Workspace::s_configuration.vramBudget, 0) * 1024 * 1024;
 
         try {
             Localization::Load(ReadJson(FormatString("misc/localizations/%s.json", Workspace::s_configuration.localizationCode.c_str())));
@@ -41,6 +50,8 @@ namespace Raster {
 
         DefaultNodeCategories::Initialize();
         Workspace::Initialize();
+        // store objects of deleted projects are only noticed here
+        ContentStore::CollectGarbage();
 
         ImGuiIO& io = ImGui::GetIO();
 
@@ -217,14 +228,25 @@ namespace Raster {
                     }
                 }
                 GPU::BindFramebuffer(std::nullopt);
+                TiledRenderer::ProcessRequests();
                 Compositor::s_bundles.clear();
+                RenderTargetPool::BeginFrame();
+                TextureResidency::BeginFrame();
                 Compositor::EnsureResolutionConstraints();
                 if (Workspace::s_project.has_value()) {
                     auto& project = Workspace::s_project.value();
                     project.currentFrame = std::max(project.currentFrame, 0.0f);
                     project.currentFrame = std::min(project.currentFrame, project.GetProjectLength());
                 }
-                Traverser::TraverseAll();
+                // only traversal and composition scale with the preview resolution, UI time is left out
+                auto traversalBeginTime = std::chrono::steady_clock::now();
+                GPU::BeginTimerQuery();
+                {
+                    GPUMemoryOwnerScope ownerScope(GPUMemoryOwner::Node);
+                    Traverser::TraverseAll();
+                }
+                GPU::EndTimerQuery();
+                auto traversalEndTime = std::chrono::steady_clock::now();
 
                 for (const auto& window : s_windows) {
                     window->Render();
@@ -232,7 +254,10 @@ namespace Raster {
 
                 ImGui::ShowDemoWindow();
 
+                auto compositionBeginTime = std::chrono::steady_clock::now();
                 Compositor::PerformComposition();
+                auto compositionEndTime = std::chrono::steady_clock::now();
+                Compositor::UpdateAdaptiveResolution(std::chrono::duration<float, std::milli>((traversalEndTime - traversalBeginTime) + (compositionEndTime - compositionBeginTime)).count());
                 GPU::BindFramebuffer(std::nullopt);
             GPU::EndFrame();
         }
@@ -243,6 +268,8 @@ namespace Raster {
             Workspace::GetProject().compositions.clear();
         }
         AsyncUpload::Terminate();
+        ShaderCompiler::Terminate();
+        RenderTargetPool::Clear();
         GPU::Terminate();
     }
 }
\ No newline at end of file
@@ -2,40 +2,201 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> ImageAsset::s_gammaPipeline;
-
     ImageAsset::ImageAsset() {
         AssetBase::Initialize();
 
         this->m_uploadID = 0;
         this->m_texture = std::nullopt;
+        this->m_residencyID = 0;
+        this->m_part = 0;
+        this->m_layer = std::nullopt;
+        this->m_parts = std::nullopt;
+        this->m_reloadRequired = false;
+        this->m_compression = std::nullopt;
+        this->m_dataAsset = false;
+        this->m_compressionFuture = std::nullopt;
+        this->m_compressionFailed = false;
+        this->m_requestedResolution = glm::vec2(0);
+        this->m_originalResolution = glm::vec2(0);
         this->m_asyncCopy = std::nullopt;
+        this->m_importProgress = nullptr;
+        this->m_thumbnail = std::nullopt;
+        this->m_thumbnailFuture = std::nullopt;
+        this->m_thumbnailFailed = false;
         this->m_loader = AsyncImageLoader();
 
         this->m_relativePath = "";
         this->m_originalPath = "";
 
-        if (!s_gammaPipeline.has_value()) {
-            s_gammaPipeline = GPU::GeneratePipeline(
-                GPU::GenerateShader(ShaderType::Vertex, "gamma_correction/shader"),
-                GPU::GenerateShader(ShaderType::Fragment, "gamma_correction/shader")
-            );
-        }
+        // the program compiles in the background while the image is still loading
+        GammaCorrection::IsReady();
+    }
+
+    bool ImageAsset::IsHigherResolutionRequired() {
+        if (!m_texture.has_value()) return false;
+        auto& texture = m_texture.value();
+        // compressed textures always hold the full resolution
+        if (texture.compressed) return false;
+        if (texture.width >= m_originalResolution.x && texture.height >= m_originalResolution.y) return false;
+        auto requiredResolution = Compositor::GetAssetResolution();
+        return requiredResolution.x > m_requestedResolution.x || requiredResolution.y > m_requestedResolution.y;
     }
 
     bool ImageAsset::AbstractIsReady() {
-        if (m_texture.has_value()) return true;
+        if (m_asyncCopy.has_value() && !IsFutureReady(m_asyncCopy.value())) return false;
+        return std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+    }
+
+    bool ImageAsset::AbstractIsLoading() {
+        if (m_asyncCopy.has_value() && !IsFutureReady(m_asyncCopy.value())) return true;
+        return m_reloadRequired || m_loader.IsInitialized() || m_uploadID != 0 || m_compressionFuture.has_value();
+    }
+
+    bool ImageAsset::IsCompressionEnabled() {
+        if (!m_compression.has_value() || m_dataAsset || m_compressionFailed) return false;
+        // HDR sources would lose their range, the encoder only takes 8-bit pixels
+        auto extension = LowerCase(GetExtension(m_relativePath));
+        return extension != ".exr" && extension != ".hdr";
+    }
+
+    std::string ImageAsset::GetCompressedImagePath() {
+        size_t layerHash = std::hash<std::string>()(m_layer.value_or(""));
+        return FormatString("%s/compressed/%i_%i_%zx_%i.etc2", Workspace::GetProject().path.c_str(), id, m_part, layerHash, (int) m_compression.value_or(TextureCompressionQuality::Balanced));
+    }
+
+    std::shared_ptr<CompressedImage> ImageAsset::TranscodeImage(std::string t_sourcePath, std::string t_cachePath, int t_part, std::optional<std::string> t_layer, TextureCompressionQuality t_quality) {
+        auto cachedCandidate = TextureCompression::Read(t_cachePath);
+        if (cachedCandidate.has_value()) return std::make_shared<CompressedImage>(std::move(cachedCandidate.value()));
+
+        ImageLoaderOptions options;
+        options.part = t_part;
+        options.layer = t_layer;
+        options.useDiskCache = true;
+        auto imageCandidate = ImageLoader::Load(t_sourcePath, options);
+        if (!imageCandidate.has_value() || !TextureCompression::IsCompressible(imageCandidate.value())) return nullptr;
+
+        auto compressedCandidate = TextureCompression::Compress(imageCandidate.value(), t_quality);
+        if (!compressedCandidate.has_value()) return nullptr;
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(std::filesystem::path(t_cachePath).parent_path(), errorCode);
+        TextureCompression::Write(t_cachePath, compressedCandidate.value());
+        return std::make_shared<CompressedImage>(std::move(compressedCandidate.value()));
+    }
+
+    std::string ImageAsset::GetThumbnailPath() {
+        return FormatString("%s/thumbnails/%i.raw", Workspace::GetProject().path.c_str(), id);
+    }
+
+    bool ImageAsset::GenerateThumbnailFile(std::string t_sourcePath, std::string t_thumbnailPath) {
+        // the image cache only touches the mip level close to the thumbnail size
+        ImageLoaderOptions options;
+        options.targetResolution = glm::vec2(THUMBNAIL_SIZE);
+        auto imageCandidate = ImageLoader::Load(t_sourcePath, options);
+        if (!imageCandidate.has_value()) return false;
+
+        auto thumbnail = ImageLoader::GenerateThumbnail(imageCandidate.value(), THUMBNAIL_SIZE);
+        auto thumbnailDirectory = std::filesystem::path(t_thumbnailPath).parent_path();
+        std::error_code errorCode;
+        std::filesystem::create_directories(thumbnailDirectory, errorCode);
+        return ImageDiskCache::WriteRawImage(t_thumbnailPath, thumbnail);
+    }
+
+    std::optional<Texture> ImageAsset::AbstractGetThumbnailTexture() {
+        if (m_thumbnail.has_value()) return m_thumbnail;
+        if (!AbstractIsReady()) return std::nullopt;
+        GPUMemoryOwnerScope ownerScope(GPUMemoryOwner::Asset);
+        // the full texture stands in for the thumbnail until it exists
+        DropEvictedTexture();
+
+        if (m_thumbnailFuture.has_value()) {
+            if (!IsFutureReady(m_thumbnailFuture.value())) return m_texture;
+            // generation is attempted once per session, a failed attempt falls back to the full texture
+            m_thumbnailFuture.value().get();
+            m_thumbnailFailed = true;
+            m_thumbnailFuture = std::nullopt;
+        }
+
+        auto thumbnailCandidate = ImageDiskCache::ReadRawImage(GetThumbnailPath());
+        if (thumbnailCandidate.has_value()) {
+            auto& thumbnail = thumbnailCandidate.value();
+            Texture texture = GPU::GenerateTexture(thumbnail.width, thumbnail.height, thumbnail.channels, TexturePrecision::Usual);
+            GPU::UpdateTexture(texture, 0, 0, thumbnail.width, thumbnail.height, thumbnail.channels, thumbnail.GetData());
+            if (!m_texture.has_value()) {
+                m_originalResolution = glm::vec2(thumbnail.originalWidth, thumbnail.originalHeight);
+            }
+            m_thumbnail = texture;
+            return m_thumbnail;
+        }
+
+        // thumbnails are missing for projects created before they existed, or for duplicated assets
+        if (!m_thumbnailFailed) {
+            std::string sourcePath = FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str());
+            std::string thumbnailPath = GetThumbnailPath();
+            m_thumbnailFuture = std::async(std::launch::async, [sourcePath, thumbnailPath]() {
+                return GenerateThumbnailFile(sourcePath, thumbnailPath);
+            });
+        }
+        return m_texture;
+    }
+
+    void ImageAsset::DropEvictedTexture() {
+        if (m_texture.has_value() && !TextureResidency::Touch(m_residencyID)) {
+            m_texture = std::nullopt;
+            m_residencyID = 0;
+        }
+    }
+
+    bool ImageAsset::EnsureTextureLoaded() {
+        GPUMemoryOwnerScope ownerScope(GPUMemoryOwner::Asset);
+        DropEvictedTexture();
+        if (m_texture.has_value() && !m_reloadRequired && !IsHigherResolutionRequired() && !m_loader.IsInitialized() && !m_uploadID && !m_compressionFuture.has_value()) return true;
         if (m_asyncCopy.has_value() && !IsFutureReady(m_asyncCopy.value())) return false;
         if (!std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) return false;
 
+        if (IsCompressionEnabled() && !m_compressionFuture.has_value() && !m_loader.IsInitialized() && !m_uploadID) {
+            m_reloadRequired = false;
+            std::string sourcePath = FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str());
+            std::string cachePath = GetCompressedImagePath();
+            int part = m_part;
+            auto layer = m_layer;
+            auto quality = m_compression.value();
+            m_compressionFuture = std::async(std::launch::async, [sourcePath, cachePath, part, layer, quality]() {
+                return TranscodeImage(sourcePath, cachePath, part, layer, quality);
+            });
+        }
+
+        if (m_compressionFuture.has_value()) {
+            if (!IsFutureReady(m_compressionFuture.value())) return m_texture.has_value();
+            auto compressedImage = m_compressionFuture.value().get();
+            m_compressionFuture = std::nullopt;
+            if (compressedImage) {
+                m_originalResolution = glm::vec2(compressedImage->originalWidth, compressedImage->originalHeight);
+                m_requestedResolution = m_originalResolution;
+                m_uploadID = AsyncUpload::GenerateTextureFromCompressedImage(compressedImage);
+            } else {
+                m_compressionFailed = true;
+            }
+        }
+
         if (!m_loader.IsInitialized() && !m_uploadID) {
-            m_loader = AsyncImageLoader(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+            ImageLoaderOptions options;
+            options.part = m_part;
+            options.layer = m_layer;
+            options.useDiskCache = true;
+            m_reloadRequired = false;
+            m_requestedResolution = Compositor::GetAssetResolution();
+            if (m_requestedResolution.x > 0 && m_requestedResolution.y > 0) {
+                options.targetResolution = m_requestedResolution;
+            }
+            m_loader = AsyncImageLoader(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()), options);
         }
 
         if (m_loader.IsInitialized() && m_loader.IsReady()) {
             auto imageCandidate = m_loader.Get();
             if (imageCandidate.has_value()) {
                 auto& image = imageCandidate.value();
+                m_originalResolution = glm::vec2(image->originalWidth, image->originalHeight);
 
                 TexturePrecision precision = TexturePrecision::Usual;
                 if (image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
@@ -43,52 +204,33 @@ namespace Raster {
 
                 if (!m_uploadID) {
                     m_uploadID = AsyncUpload::GenerateTextureFromImage(image);
-                    m_loader = AsyncImageLoader();   
                 }
             }
+            m_loader = AsyncImageLoader();
         }
-        if (AsyncUpload::IsUploadReady(m_uploadID)) {
+        // EXR uploads wait for the gamma correction program, it may still be compiling in the background
+        bool gammaCorrectionRequired = GammaCorrection::IsRequired(m_relativePath);
+        if (AsyncUpload::IsUploadReady(m_uploadID) && (!gammaCorrectionRequired || GammaCorrection::IsReady())) {
             auto& info = AsyncUpload::GetUpload(m_uploadID);
+            if (m_texture.has_value()) {
+                TextureResidency::Unregister(m_residencyID);
+                GPU::DestroyTexture(m_texture.value());
+            }
             m_texture = info.texture;
+            m_residencyID = TextureResidency::Register(info.texture);
 
-            if (s_gammaPipeline.has_value() && GetExtension(m_relativePath) == ".exr") {
-                auto& pipeline = s_gammaPipeline.value();
-                Texture copiedTexture = GPU::GenerateTexture(info.texture.width, info.texture.height, info.texture.channels, info.texture.precision);
-                Texture gammaTexture = GPU::GenerateTexture(info.texture.width, info.texture.height, info.texture.channels, info.texture.precision);
-
-                Framebuffer gammaFbo = GPU::GenerateFramebuffer(info.texture.width, info.texture.height, {gammaTexture});
-
-                GPU::BlitTexture(copiedTexture, info.texture);
-
-                GPU::BindFramebuffer(gammaFbo);
-                GPU::BindPipeline(pipeline);
-                GPU::ClearFramebuffer(0, 0, 0, 0);
-
-                GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(info.texture.width, info.texture.height));
-                GPU::SetShaderUniform(pipeline.fragment, "uGamma", 2.2f);
-                GPU::BindTextureToShader(pipeline.fragment, "uColor", copiedTexture, 0);
-                GPU::SetShaderUniform(pipeline.fragment, "uUVAvailable", 0);
-
-                GPU::DrawArrays(3);
-
-                GPU::BindFramebuffer(std::nullopt);
-
-                GPU::BlitTexture(info.texture, gammaTexture);
-
-                GPU::DestroyTexture(copiedTexture);
-                GPU::DestroyTexture(gammaTexture);
-                GPU::DestroyFramebuffer(gammaFbo);
+            if (gammaCorrectionRequired) {
+                GammaCorrection::Apply(info.texture);
             }
 
-            
-
             AsyncUpload::DestroyUpload(m_uploadID);
         }
 
-        return false;
+        return m_texture.has_value();
     }
 
     std::optional<Texture> ImageAsset::AbstractGetPreviewTexture() {
+        EnsureTextureLoaded();
         return m_texture;
     }
 
@@ -100,9 +242,8 @@ namespace Raster {
     }
 
     std::optional<std::string> ImageAsset::AbstractGetResolution() {
-        if (m_texture.has_value()) {
-            auto& texture = m_texture.value();
-            return FormatString("%ix%i", (int) texture.width, (int) texture.height);
+        if (m_originalResolution.x > 0 && m_originalResolution.y > 0) {
+            return FormatString("%ix%i", (int) m_originalResolution.x, (int) m_originalResolution.y);
         }
         return std::nullopt;
     }
@@ -116,9 +257,13 @@ namespace Raster {
         std::string relativePath = FormatString("%i%s", id, GetExtension(t_path).c_str());
         std::string absolutePath = FormatString("%s/%s", Workspace::GetProject().path.c_str(), relativePath.c_str());
         this->m_relativePath = relativePath;
-        this->m_asyncCopy = std::async(std::launch::async, [t_path, absolutePath]() {
-            std::filesystem::copy(t_path, absolutePath);
-            return true;
+        std::string thumbnailPath = GetThumbnailPath();
+        auto importProgress = std::make_shared<ContentImportProgress>();
+        this->m_importProgress = importProgress;
+        this->m_asyncCopy = std::async(std::launch::async, [t_path, absolutePath, thumbnailPath, importProgress]() {
+            bool success = ContentStore::Import(t_path, absolutePath, importProgress);
+            GenerateThumbnailFile(t_path, thumbnailPath);
+            return success;
         });
         this->name = GetBaseName(t_path);
     }
@@ -126,23 +271,125 @@ namespace Raster {
     Json ImageAsset::AbstractSerialize() {
         return {
             {"RelativePath", m_relativePath},
-            {"OriginalPath", m_originalPath}
+            {"OriginalPath", m_originalPath},
+            {"Part", m_part},
+            {"Layer", m_layer.has_value() ? Json(m_layer.value()) : Json(nullptr)},
+            {"Compression", m_compression.has_value()},
+            {"CompressionQuality", (int) m_compression.value_or(TextureCompressionQuality::Balanced)},
+            {"DataAsset", m_dataAsset}
         };
     }
 
     void ImageAsset::AbstractLoad(Json t_data) {
         this->m_relativePath = t_data["RelativePath"];
         this->m_originalPath = t_data["OriginalPath"];
+        if (t_data.contains("Part")) this->m_part = t_data["Part"];
+        if (t_data.contains("Layer") && !t_data["Layer"].is_null()) this->m_layer = t_data["Layer"].get<std::string>();
+        if (t_data.contains("Compression") && t_data["Compression"].get<bool>()) {
+            this->m_compression = (TextureCompressionQuality) t_data["CompressionQuality"].get<int>();
+        }
+        if (t_data.contains("DataAsset")) this->m_dataAsset = t_data["DataAsset"];
     }
 
     void ImageAsset::AbstractRenderDetails() {
-        if (!IsReady()) {
+        if (m_importProgress && m_asyncCopy.has_value() && !IsFutureReady(m_asyncCopy.value())) {
+            auto& progress = *m_importProgress;
+            std::string stageName = Localization::GetString(progress.stage == ContentImportStage::Hashing ? "HASHING_CONTENT" : progress.stage == ContentImportStage::Copying ? "COPYING_CONTENT" : "LINKING_CONTENT");
+            ImGui::Text("%s %s", ICON_FA_FILE_IMPORT, stageName.c_str());
+            ImGui::ProgressBar(progress.GetPercentage(), ImVec2(-1, 0));
+        } else if (!IsReady() || !EnsureTextureLoaded()) {
             ImGui::Text("%s %s", ICON_FA_SPINNER, Localization::GetString("IMAGE_IS_NOT_READY_FOR_USE_YET").c_str());
         } else {
             auto& texture = m_texture.value();
-            ImGui::Text("%s %s: %ix%i", ICON_FA_EXPAND, Localization::GetString("IMAGE_RESOLUTION").c_str(), (int) texture.width, (int) texture.height);
+            ImGui::Text("%s %s: %ix%i", ICON_FA_EXPAND, Localization::GetString("IMAGE_RESOLUTION").c_str(), (int) m_originalResolution.x, (int) m_originalResolution.y);
+            if (texture.width != m_originalResolution.x || texture.height != m_originalResolution.y) {
+                ImGui::Text("%s %s: %ix%i", ICON_FA_LAYER_GROUP, Localization::GetString("LOADED_MIP_RESOLUTION").c_str(), (int) texture.width, (int) texture.height);
+            }
             ImGui::Text("%s %s: %0.2f", ICON_FA_IMAGE, Localization::GetString("ASPECT_RATIO").c_str(), (float) texture.width / (float) texture.height);
             ImGui::Text("%s %s: %i", ICON_FA_DROPLET, Localization::GetString("NUMBER_OF_CHANNELS").c_str(), texture.channels);
+            ImGui::Text("%s %s: %s", ICON_FA_MEMORY, Localization::GetString("TEXTURE_FORMAT").c_str(), texture.GetShortPrecisionInfo().c_str());
+            if (m_compressionFuture.has_value()) {
+                ImGui::Text("%s %s", ICON_FA_SPINNER, Localization::GetString("COMPRESSING_TEXTURE").c_str());
+            }
+            RenderPartSelector();
+            RenderCompressionSettings();
+        }
+    }
+
+    void ImageAsset::RenderCompressionSettings() {
+        static std::vector<std::string> s_qualityKeys = {"COMPRESSION_FAST", "COMPRESSION_BALANCED", "COMPRESSION_HIGH"};
+
+        bool settingsChanged = false;
+        if (ImGui::Checkbox(FormatString("%s %s", ICON_FA_TABLE_CELLS, Localization::GetString("DATA_ASSET").c_str()).c_str(), &m_dataAsset)) {
+            settingsChanged = true;
+        }
+        ImGui::SetItemTooltip("%s %s", ICON_FA_CIRCLE_INFO, Localization::GetString("DATA_ASSET_HINT").c_str());
+
+        ImGui::BeginDisabled(m_dataAsset);
+        std::string currentQualityName = m_compression.has_value() ? Localization::GetString(s_qualityKeys[(int) m_compression.value()]) : Localization::GetString("COMPRESSION_DISABLED");
+        if (ImGui::BeginCombo(FormatString("%s %s", ICON_FA_FILE_ZIPPER, Localization::GetString("TEXTURE_COMPRESSION").c_str()).c_str(), currentQualityName.c_str())) {
+            if (ImGui::Selectable(Localization::GetString("COMPRESSION_DISABLED").c_str(), !m_compression.has_value())) {
+                m_compression = std::nullopt;
+                settingsChanged = true;
+            }
+            for (int quality = 0; quality < (int) s_qualityKeys.size(); quality++) {
+                bool selected = m_compression.has_value() && (int) m_compression.value() == quality;
+                if (ImGui::Selectable(Localization::GetString(s_qualityKeys[quality]).c_str(), selected)) {
+                    m_compression = (TextureCompressionQuality) quality;
+                    settingsChanged = true;
+                }
+            }
+            ImGui::EndCombo();
+        }
+        ImGui::EndDisabled();
+
+        if (settingsChanged) {
+            m_compressionFailed = false;
+            m_reloadRequired = true;
+        }
+    }
+
+    void ImageAsset::RenderPartSelector() {
+        if (!m_parts.has_value()) {
+            m_parts = ImageLoader::GetParts(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+        }
+        auto& parts = m_parts.value();
+        bool hasLayers = false;
+        for (auto& part : parts) {
+            if (part.layers.size() > 1) hasLayers = true;
+        }
+        if (parts.size() <= 1 && !hasLayers) return;
+
+        auto getLayerName = [](std::string t_layer) {
+            return t_layer.empty() ? std::string("RGBA") : t_layer;
+        };
+
+        if (parts.size() > 1) {
+            std::string currentPartName = m_part < (int) parts.size() ? parts[m_part].name : FormatString("#%i", m_part);
+            if (ImGui::BeginCombo(FormatString("%s %s", ICON_FA_LAYER_GROUP, Localization::GetString("IMAGE_PART").c_str()).c_str(), currentPartName.c_str())) {
+                for (auto& part : parts) {
+                    if (ImGui::Selectable(FormatString("%s (%i)", part.name.c_str(), part.channels).c_str(), part.index == m_part)) {
+                        m_part = part.index;
+                        m_layer = std::nullopt;
+                        m_reloadRequired = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+        }
+
+        if (m_part < (int) parts.size() && parts[m_part].layers.size() > 1) {
+            auto& layers = parts[m_part].layers;
+            std::string currentLayerName = m_layer.has_value() ? getLayerName(m_layer.value()) : Localization::GetString("DEFAULT_LAYER");
+            if (ImGui::BeginCombo(FormatString("%s %s", ICON_FA_DROPLET, Localization::GetString("IMAGE_LAYER").c_str()).c_str(), currentLayerName.c_str())) {
+                for (auto& layer : layers) {
+                    if (ImGui::Selectable(getLayerName(layer).c_str(), m_layer.has_value() && m_layer.value() == layer)) {
+                        m_layer = layer;
+                        m_reloadRequired = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
         }
     }
 
@@ -150,10 +397,27 @@ namespace Raster {
         if (std::filesystem::exists(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()))) {
             std::filesystem::remove(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
         }
+        ContentStore::Release(FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str()));
+
+        if (std::filesystem::exists(GetThumbnailPath())) {
+            std::filesystem::remove(GetThumbnailPath());
+        }
 
-        auto textureCandidate = AbstractGetPreviewTexture();
-        if (textureCandidate.has_value()) {
-            GPU::DestroyTexture(textureCandidate.value());
+        // every part, layer and quality transcoded so far
+        std::error_code errorCode;
+        std::string compressedPrefix = FormatString("%i_", id);
+        for (auto& entry : std::filesystem::directory_iterator(FormatString("%s/compressed", Workspace::GetProject().path.c_str()), errorCode)) {
+            if (entry.path().filename().string().rfind(compressedPrefix, 0) == 0) {
+                std::filesystem::remove(entry.path(), errorCode);
+            }
+        }
+
+        if (m_texture.has_value()) {
+            TextureResidency::Unregister(m_residencyID);
+            GPU::DestroyTexture(m_texture.value());
+        }
+        if (m_thumbnail.has_value()) {
+            GPU::DestroyTexture(m_thumbnail.value());
         }
     }
 };
@@ -2,9 +2,18 @@
 
 #include "common/asset_base.h"
 #include "gpu/async_upload.h"
+#include "gpu/texture_residency.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
+#include "gpu/gamma_correction.h"
+#include "compositor/compositor.h"
+#include "image/disk_cache.h"
+#include "image/texture_compression.h"
+#include "common/content_store.h"
 #include "../../ImGui/imgui.h"
 
+#define THUMBNAIL_SIZE 128
+
 namespace Raster {
     struct ImageAsset : public AssetBase {
     public:
@@ -12,8 +21,10 @@ namespace Raster {
 
     private:
         bool AbstractIsReady();
+        bool AbstractIsLoading();
 
         std::optional<Texture> AbstractGetPreviewTexture();
+        std::optional<Texture> AbstractGetThumbnailTexture();
         void AbstractImport(std::string t_path);
 
         void AbstractLoad(Json t_data);
@@ -27,6 +38,26 @@ namespace Raster {
         std::optional<std::string> AbstractGetResolution();
         std::optional<std::string> AbstractGetPath();
 
+        // preview only needs the mip level matching the compositor resolution,
+        // higher levels are streamed in once the required resolution grows
+        bool IsHigherResolutionRequired();
+
+        void RenderPartSelector();
+        void RenderCompressionSettings();
+
+        // full resolution is only decoded and uploaded once the asset is actually used
+        bool EnsureTextureLoaded();
+        // forgets the texture if TextureResidency evicted it, the next EnsureTextureLoaded() loads it again
+        void DropEvictedTexture();
+
+        // compressed textures are transcoded once at full resolution and cached next to the thumbnails
+        bool IsCompressionEnabled();
+        std::string GetCompressedImagePath();
+        static std::shared_ptr<CompressedImage> TranscodeImage(std::string t_sourcePath, std::string t_cachePath, int t_part, std::optional<std::string> t_layer, TextureCompressionQuality t_quality);
+
+        std::string GetThumbnailPath();
+        static bool GenerateThumbnailFile(std::string t_sourcePath, std::string t_thumbnailPath);
+
         std::string m_relativePath;
         std::string m_originalPath;
 
@@ -34,9 +65,26 @@ namespace Raster {
         AsyncImageLoader m_loader;
 
         std::optional<std::future<bool>> m_asyncCopy;
+        std::shared_ptr<ContentImportProgress> m_importProgress;
 
-        std::optional<Texture> m_texture;
+        int m_part;
+        std::optional<std::string> m_layer;
+        std::optional<std::vector<ImagePartInfo>> m_parts;
+        bool m_reloadRequired;
 
-        static std::optional<Pipeline> s_gammaPipeline;
+        std::optional<TextureCompressionQuality> m_compression;
+        // data assets (UV maps, masks, lookup tables) are sampled as values and never compressed
+        bool m_dataAsset;
+        std::optional<std::future<std::shared_ptr<CompressedImage>>> m_compressionFuture;
+        // set once transcoding was impossible, the uncompressed path is used until the settings change
+        bool m_compressionFailed;
+
+        std::optional<Texture> m_texture;
+        TextureResidencyID m_residencyID;
+        std::optional<Texture> m_thumbnail;
+        std::optional<std::future<bool>> m_thumbnailFuture;
+        bool m_thumbnailFailed;
+        glm::vec2 m_requestedResolution;
+        glm::vec2 m_originalResolution;
     };
 };
\ No newline at end of file
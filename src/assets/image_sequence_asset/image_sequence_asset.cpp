@@ -0,0 +1,340 @@
+#include "image_sequence_asset.h"
+#include <charconv>
+
+namespace Raster {
+
+    ImageSequenceAsset::ImageSequenceAsset() {
+        AssetBase::Initialize();
+
+        this->m_directory = "";
+        this->m_prefix = "";
+        this->m_suffix = "";
+        this->m_padding = 0;
+        this->m_originalPath = "";
+
+        this->m_readAheadFrames = 24;
+        this->m_ramBudgetMB = 1024;
+        this->m_vramBudgetMB = 512;
+
+        this->m_lastFrameNumber = std::nullopt;
+        this->m_missingFrameNumber = std::nullopt;
+
+        // the program compiles in the background while the first frames are decoding
+        GammaCorrection::IsReady();
+    }
+
+    bool ImageSequenceAsset::AbstractIsReady() {
+        CollectDecodedFrames();
+        return !m_frames.empty();
+    }
+
+    bool ImageSequenceAsset::AbstractIsLoading() {
+        return m_missingFrameNumber.has_value();
+    }
+
+    std::optional<Texture> ImageSequenceAsset::AbstractGetPreviewTexture() {
+        if (m_lastFrameNumber.has_value() && m_frameTextures.find(m_lastFrameNumber.value()) != m_frameTextures.end()) {
+            return m_frameTextures[m_lastFrameNumber.value()];
+        }
+        return AbstractGetFrameTexture(0);
+    }
+
+    std::optional<Texture> ImageSequenceAsset::AbstractGetFrameTexture(float t_frame) {
+        CollectDecodedFrames();
+
+        auto frameNumberCandidate = ResolveFrameNumber(t_frame);
+        if (!frameNumberCandidate.has_value()) return std::nullopt;
+        auto frameNumber = frameNumberCandidate.value();
+
+        std::optional<Texture> result = std::nullopt;
+        if (m_frameTextures.find(frameNumber) != m_frameTextures.end()) {
+            result = m_frameTextures[frameNumber];
+        } else if (m_decodedFrames.find(frameNumber) != m_decodedFrames.end() && (!GammaCorrection::IsRequired(m_originalPath) || GammaCorrection::IsReady())) {
+            auto& image = m_decodedFrames[frameNumber];
+
+            TexturePrecision precision = TexturePrecision::Usual;
+            if (image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
+            if (image->precision == ImagePrecision::Full) precision = TexturePrecision::Full;
+
+            auto texture = GPU::GenerateTexture(image->width, image->height, image->channels, precision);
+            GPU::UpdateTexture(texture, 0, 0, image->width, image->height, image->channels, image->GetData());
+            // same pixels as the frame imported as a single image asset
+            if (GammaCorrection::IsRequired(m_originalPath)) {
+                GammaCorrection::Apply(texture);
+            }
+
+            // uploaded frames live in VRAM only, RAM is reserved for frames ahead of the playhead
+            m_decodedFrames.erase(frameNumber);
+            m_frameTextures[frameNumber] = texture;
+            result = texture;
+        } else if (m_decodedFrames.find(frameNumber) == m_decodedFrames.end() && m_pendingFrames.find(frameNumber) == m_pendingFrames.end()) {
+            m_pendingFrames[frameNumber] = ImageDecodePool::Decode(GetFramePath(frameNumber));
+        }
+
+        ScheduleReadAhead(frameNumber);
+        EnforceBudgets(frameNumber);
+
+        if (result.has_value()) {
+            m_lastFrameNumber = frameNumber;
+            m_missingFrameNumber = std::nullopt;
+            return result;
+        }
+        m_missingFrameNumber = frameNumber;
+
+        // hold the previously shown frame while the requested one is still decoding
+        if (m_lastFrameNumber.has_value() && m_frameTextures.find(m_lastFrameNumber.value()) != m_frameTextures.end()) {
+            return m_frameTextures[m_lastFrameNumber.value()];
+        }
+        return std::nullopt;
+    }
+
+    std::optional<int> ImageSequenceAsset::ResolveFrameNumber(float t_frame) {
+        if (m_frames.empty()) return std::nullopt;
+        int targetFrame = m_frames.front() + (int) std::floor(t_frame);
+        if (targetFrame <= m_frames.front()) return m_frames.front();
+        if (targetFrame >= m_frames.back()) return m_frames.back();
+
+        // missing frames are held to the nearest previous existing frame
+        auto upperBound = std::upper_bound(m_frames.begin(), m_frames.end(), targetFrame);
+        return *(upperBound - 1);
+    }
+
+    void ImageSequenceAsset::CollectDecodedFrames() {
+        for (auto it = m_pendingFrames.begin(); it != m_pendingFrames.end();) {
+            if (!IsFutureReady(it->second)) {
+                it++;
+                continue;
+            }
+            auto imageCandidate = it->second.get();
+            if (imageCandidate.has_value()) {
+                m_decodedFrames[it->first] = imageCandidate.value();
+            } else {
+                print("failed to decode image sequence frame " << GetFramePath(it->first));
+            }
+            it = m_pendingFrames.erase(it);
+        }
+    }
+
+    void ImageSequenceAsset::ScheduleReadAhead(int t_frameNumber) {
+        auto frameIterator = std::lower_bound(m_frames.begin(), m_frames.end(), t_frameNumber);
+        if (frameIterator == m_frames.end()) return;
+
+        // never schedule more frames than the RAM budget is able to hold
+        int readAheadFrames = m_readAheadFrames;
+        if (!m_decodedFrames.empty()) {
+            size_t frameSize = std::max(GetImageSize(m_decodedFrames.begin()->second), (size_t) 1);
+            readAheadFrames = std::min(readAheadFrames, (int) (((size_t) m_ramBudgetMB * 1024 * 1024) / frameSize));
+        }
+
+        int scheduledFrames = 0;
+        for (auto it = frameIterator + 1; it != m_frames.end() && scheduledFrames < readAheadFrames; it++, scheduledFrames++) {
+            int frameNumber = *it;
+            if (m_frameTextures.find(frameNumber) != m_frameTextures.end()) continue;
+            if (m_decodedFrames.find(frameNumber) != m_decodedFrames.end()) continue;
+            if (m_pendingFrames.find(frameNumber) != m_pendingFrames.end()) continue;
+            m_pendingFrames[frameNumber] = ImageDecodePool::Decode(GetFramePath(frameNumber));
+        }
+    }
+
+    void ImageSequenceAsset::EnforceBudgets(int t_frameNumber) {
+        // frames behind the playhead are evicted first, then the ones farthest ahead of it.
+        // The previously shown frame is kept as well, it stands in while the requested one is still decoding
+        auto evictionPriority = [t_frameNumber](int t_candidate) {
+            if (t_candidate < t_frameNumber) return (int64_t) INT32_MAX + (t_frameNumber - t_candidate);
+            return (int64_t) (t_candidate - t_frameNumber);
+        };
+
+        size_t ramBudget = (size_t) m_ramBudgetMB * 1024 * 1024;
+        size_t ramUsage = 0;
+        for (auto& decoded : m_decodedFrames) {
+            ramUsage += GetImageSize(decoded.second);
+        }
+        while (ramUsage > ramBudget && !m_decodedFrames.empty()) {
+            auto victim = m_decodedFrames.begin();
+            for (auto it = m_decodedFrames.begin(); it != m_decodedFrames.end(); it++) {
+                if (evictionPriority(it->first) > evictionPriority(victim->first)) victim = it;
+            }
+            ramUsage -= GetImageSize(victim->second);
+            m_decodedFrames.erase(victim);
+        }
+
+        size_t vramBudget = (size_t) m_vramBudgetMB * 1024 * 1024;
+        size_t vramUsage = 0;
+        for (auto& texture : m_frameTextures) {
+            vramUsage += GetTextureSize(texture.second);
+        }
+        while (vramUsage > vramBudget && m_frameTextures.size() > 1) {
+            auto victim = m_frameTextures.end();
+            for (auto it = m_frameTextures.begin(); it != m_frameTextures.end(); it++) {
+                if (it->first == t_frameNumber || (m_lastFrameNumber.has_value() && it->first == m_lastFrameNumber.value())) continue;
+                if (victim == m_frameTextures.end() || evictionPriority(it->first) > evictionPriority(victim->first)) victim = it;
+            }
+            if (victim == m_frameTextures.end()) break;
+            vramUsage -= GetTextureSize(victim->second);
+            GPU::DestroyTexture(victim->second);
+            m_frameTextures.erase(victim);
+        }
+    }
+
+    size_t ImageSequenceAsset::GetImageSize(std::shared_ptr<Image>& t_image) {
+        return t_image->GetDataSize();
+    }
+
+    size_t ImageSequenceAsset::GetTextureSize(Texture& t_texture) {
+        size_t channelSize = 1;
+        if (t_texture.precision == TexturePrecision::Half) channelSize = 2;
+        if (t_texture.precision == TexturePrecision::Full) channelSize = 4;
+        return (size_t) t_texture.width * t_texture.height * t_texture.channels * channelSize;
+    }
+
+    std::string ImageSequenceAsset::GetFramePath(int t_frameNumber) {
+        if (m_padding == 0) return m_originalPath;
+        return FormatString("%s/%s%0*i%s", m_directory.c_str(), m_prefix.c_str(), m_padding, t_frameNumber, m_suffix.c_str());
+    }
+
+    void ImageSequenceAsset::ScanFrames() {
+        m_frames.clear();
+        if (m_padding == 0) {
+            // file without a frame number is treated as a single-frame sequence
+            if (std::filesystem::exists(m_originalPath)) m_frames.push_back(0);
+            return;
+        }
+        if (!std::filesystem::exists(m_directory)) return;
+
+        for (auto& entry : std::filesystem::directory_iterator(m_directory)) {
+            if (!entry.is_regular_file()) continue;
+            std::string filename = entry.path().filename().string();
+            if (filename.size() <= m_prefix.size() + m_suffix.size()) continue;
+            if (filename.compare(0, m_prefix.size(), m_prefix) != 0) continue;
+            if (filename.compare(filename.size() - m_suffix.size(), m_suffix.size(), m_suffix) != 0) continue;
+
+            std::string digits = filename.substr(m_prefix.size(), filename.size() - m_prefix.size() - m_suffix.size());
+            if (!std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit((unsigned char) c); })) continue;
+            // unpadded numbers may only grow wider than the padding without leading zeros
+            if ((int) digits.size() != m_padding && ((int) digits.size() < m_padding || digits[0] == '0')) continue;
+
+            // numbers too wide for an int are skipped instead of aborting the scan
+            int frameNumber;
+            auto [end, errorCode] = std::from_chars(digits.data(), digits.data() + digits.size(), frameNumber);
+            if (errorCode != std::errc() || end != digits.data() + digits.size()) continue;
+            m_frames.push_back(frameNumber);
+        }
+        std::sort(m_frames.begin(), m_frames.end());
+    }
+
+    std::optional<std::uintmax_t> ImageSequenceAsset::AbstractGetSize() {
+        std::uintmax_t size = 0;
+        for (auto& frameNumber : m_frames) {
+            std::string framePath = GetFramePath(frameNumber);
+            if (std::filesystem::exists(framePath)) {
+                size += std::filesystem::file_size(framePath);
+            }
+        }
+        return size;
+    }
+
+    std::optional<std::string> ImageSequenceAsset::AbstractGetResolution() {
+        for (auto& texture : m_frameTextures) {
+            return FormatString("%ix%i", (int) texture.second.width, (int) texture.second.height);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::string> ImageSequenceAsset::AbstractGetDuration() {
+        if (m_frames.empty()) return std::nullopt;
+        return FormatString("%i %s", (int) m_frames.size(), Localization::GetString("FRAMES").c_str());
+    }
+
+    std::optional<std::string> ImageSequenceAsset::AbstractGetPath() {
+        return m_originalPath;
+    }
+
+    void ImageSequenceAsset::AbstractImport(std::string t_path) {
+        // sequences are usually too large to be copied into the project, so frames are referenced in place
+        this->m_originalPath = t_path;
+        std::filesystem::path path(t_path);
+        this->m_directory = path.parent_path().string();
+        this->m_suffix = path.extension().string();
+
+        std::string stem = path.stem().string();
+        std::smatch match;
+        if (std::regex_match(stem, match, std::regex("^(.*?)([0-9]+)$"))) {
+            this->m_prefix = match[1].str();
+            this->m_padding = (int) match[2].str().size();
+        } else {
+            this->m_prefix = stem;
+            this->m_padding = 0;
+        }
+        this->name = m_padding == 0 ? GetBaseName(t_path) : FormatString("%s%s%s", m_prefix.c_str(), std::string(m_padding, '#').c_str(), m_suffix.c_str());
+
+        ScanFrames();
+    }
+
+    Json ImageSequenceAsset::AbstractSerialize() {
+        return {
+            {"Directory", m_directory},
+            {"Prefix", m_prefix},
+            {"Suffix", m_suffix},
+            {"Padding", m_padding},
+            {"OriginalPath", m_originalPath},
+            {"ReadAheadFrames", m_readAheadFrames},
+            {"RAMBudget", m_ramBudgetMB},
+            {"VRAMBudget", m_vramBudgetMB}
+        };
+    }
+
+    void ImageSequenceAsset::AbstractLoad(Json t_data) {
+        this->m_directory = t_data["Directory"];
+        this->m_prefix = t_data["Prefix"];
+        this->m_suffix = t_data["Suffix"];
+        this->m_padding = t_data["Padding"];
+        this->m_originalPath = t_data["OriginalPath"];
+        if (t_data.contains("ReadAheadFrames")) this->m_readAheadFrames = t_data["ReadAheadFrames"];
+        if (t_data.contains("RAMBudget")) this->m_ramBudgetMB = t_data["RAMBudget"];
+        if (t_data.contains("VRAMBudget")) this->m_vramBudgetMB = t_data["VRAMBudget"];
+
+        ScanFrames();
+    }
+
+    void ImageSequenceAsset::AbstractRenderDetails() {
+        if (m_frames.empty()) {
+            ImGui::Text("%s %s", ICON_FA_TRIANGLE_EXCLAMATION, Localization::GetString("IMAGE_SEQUENCE_IS_EMPTY").c_str());
+            return;
+        }
+        ImGui::Text("%s %s: %i - %i (%i)", ICON_FA_LIST_OL, Localization::GetString("FRAME_RANGE").c_str(), m_frames.front(), m_frames.back(), (int) m_frames.size());
+        auto resolutionCandidate = AbstractGetResolution();
+        if (resolutionCandidate.has_value()) {
+            ImGui::Text("%s %s: %s", ICON_FA_EXPAND, Localization::GetString("IMAGE_RESOLUTION").c_str(), resolutionCandidate.value().c_str());
+        }
+        ImGui::Text("%s %s: %i / %i / %i", ICON_FA_FORWARD, Localization::GetString("CACHED_FRAMES").c_str(), (int) m_frameTextures.size(), (int) m_decodedFrames.size(), (int) m_pendingFrames.size());
+
+        ImGui::DragInt(FormatString("%s %s", ICON_FA_FORWARD, Localization::GetString("READ_AHEAD_FRAMES").c_str()).c_str(), &m_readAheadFrames, 1, 0, 240);
+        ImGui::DragInt(FormatString("%s %s", ICON_FA_MEMORY, Localization::GetString("RAM_BUDGET_MB").c_str()).c_str(), &m_ramBudgetMB, 8, 64, 65536);
+        ImGui::DragInt(FormatString("%s %s", ICON_FA_MEMORY, Localization::GetString("VRAM_BUDGET_MB").c_str()).c_str(), &m_vramBudgetMB, 8, 64, 65536);
+    }
+
+    void ImageSequenceAsset::AbstractDelete() {
+        for (auto& texture : m_frameTextures) {
+            GPU::DestroyTexture(texture.second);
+        }
+        m_frameTextures.clear();
+        m_decodedFrames.clear();
+        m_pendingFrames.clear();
+        m_missingFrameNumber = std::nullopt;
+    }
+};
+
+extern "C" {
+    Raster::AbstractAsset SpawnAsset() {
+        return (Raster::AbstractAsset) std::make_shared<Raster::ImageSequenceAsset>();
+    }
+
+    Raster::AssetDescription GetDescription() {
+        return Raster::AssetDescription{
+            .prettyName = "Image Sequence Asset",
+            .packageName = RASTER_PACKAGED "image_sequence_asset",
+            .icon = ICON_FA_FILM,
+            .extensions = Raster::ImageLoader::GetSupportedExtensions()
+        };
+    }
+}
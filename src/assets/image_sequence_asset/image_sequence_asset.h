@@ -0,0 +1,66 @@
+#pragma once
+
+#include "common/asset_base.h"
+#include "gpu/gpu.h"
+#include "gpu/gamma_correction.h"
+#include "image/image.h"
+#include "../../ImGui/imgui.h"
+
+namespace Raster {
+    struct ImageSequenceAsset : public AssetBase {
+    public:
+        ImageSequenceAsset();
+
+    private:
+        bool AbstractIsReady();
+        bool AbstractIsLoading();
+
+        std::optional<Texture> AbstractGetPreviewTexture();
+        std::optional<Texture> AbstractGetFrameTexture(float t_frame);
+        void AbstractImport(std::string t_path);
+
+        void AbstractLoad(Json t_data);
+        Json AbstractSerialize();
+
+        void AbstractRenderDetails();
+
+        void AbstractDelete();
+
+        std::optional<std::uintmax_t> AbstractGetSize();
+        std::optional<std::string> AbstractGetResolution();
+        std::optional<std::string> AbstractGetDuration();
+        std::optional<std::string> AbstractGetPath();
+
+        // finds all files that share prefix, suffix and padding with the sequence
+        void ScanFrames();
+        std::string GetFramePath(int t_frameNumber);
+        std::optional<int> ResolveFrameNumber(float t_frame);
+
+        void CollectDecodedFrames();
+        void ScheduleReadAhead(int t_frameNumber);
+        void EnforceBudgets(int t_frameNumber);
+
+        static size_t GetImageSize(std::shared_ptr<Image>& t_image);
+        static size_t GetTextureSize(Texture& t_texture);
+
+        std::string m_directory;
+        std::string m_prefix;
+        std::string m_suffix;
+        int m_padding;
+        std::string m_originalPath;
+
+        // sorted frame numbers found on disk, gaps are allowed
+        std::vector<int> m_frames;
+
+        int m_readAheadFrames;
+        int m_ramBudgetMB;
+        int m_vramBudgetMB;
+
+        std::unordered_map<int, std::future<ImageDecodeResult>> m_pendingFrames;
+        std::unordered_map<int, std::shared_ptr<Image>> m_decodedFrames;
+        std::unordered_map<int, Texture> m_frameTextures;
+        std::optional<int> m_lastFrameNumber;
+        // frame that was asked for but is still decoding, m_lastFrameNumber is shown in the meantime
+        std::optional<int> m_missingFrameNumber;
+    };
+};
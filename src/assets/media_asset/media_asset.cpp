@@ -13,9 +13,10 @@ namespace Raster {
         std::string relativePath = FormatString("%i%s", id, GetExtension(t_path).c_str());
         std::string absolutePath = FormatString("%s/%s", Workspace::GetProject().path.c_str(), relativePath.c_str());
         this->m_relativePath = relativePath;
-        m_copyFuture = std::async(std::launch::async, [t_path, absolutePath]() {
-            std::filesystem::copy(t_path, absolutePath);
-            return true;
+        auto importProgress = std::make_shared<ContentImportProgress>();
+        this->m_importProgress = importProgress;
+        m_copyFuture = std::async(std::launch::async, [t_path, absolutePath, importProgress]() {
+            return ContentStore::Import(t_path, absolutePath, importProgress);
         });
 
         this->name = GetBaseName(t_path);
@@ -26,9 +27,15 @@ namespace Raster {
         if (std::filesystem::exists(absolutePath) && !std::filesystem::is_directory(absolutePath)) {
             std::filesystem::remove(absolutePath);
         }
+        ContentStore::Release(absolutePath);
+    }
+
+    bool MediaAsset::AbstractIsLoading() {
+        return m_copyFuture.has_value() && !IsFutureReady(m_copyFuture.value());
     }
 
     bool MediaAsset::AbstractIsReady() {
+        if (m_copyFuture.has_value() && !IsFutureReady(m_copyFuture.value())) return false;
         std::string absolutePath = FormatString("%s/%s", Workspace::GetProject().path.c_str(), m_relativePath.c_str());
         if (std::filesystem::exists(absolutePath) && !std::filesystem::is_directory(absolutePath) && !m_formatCtx.isOpened() && !m_formatCtxWasOpened) {
             std::error_code ec;
@@ -102,7 +109,12 @@ namespace Raster {
     }
 
     void MediaAsset::AbstractRenderDetails() {
-
+        if (m_importProgress && m_copyFuture.has_value() && !IsFutureReady(m_copyFuture.value())) {
+            auto& progress = *m_importProgress;
+            std::string stageName = Localization::GetString(progress.stage == ContentImportStage::Hashing ? "HASHING_CONTENT" : progress.stage == ContentImportStage::Copying ? "COPYING_CONTENT" : "LINKING_CONTENT");
+            ImGui::Text("%s %s", ICON_FA_FILE_IMPORT, stageName.c_str());
+            ImGui::ProgressBar(progress.GetPercentage(), ImVec2(-1, 0));
+        }
     }
 };
 
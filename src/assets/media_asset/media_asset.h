@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/assets.h"
+#include "common/content_store.h"
 #include "gpu/gpu.h"
 #include "../../ImGui/imgui.h"
 #include "font/font.h"
@@ -28,6 +29,7 @@ namespace Raster {
 
     private:
         bool AbstractIsReady();
+        bool AbstractIsLoading();
 
         void AbstractImport(std::string t_path);
         void AbstractDelete();
@@ -50,5 +52,6 @@ namespace Raster {
         bool m_formatCtxWasOpened;
         std::optional<Texture> m_attachedPicTexture;
         std::optional<std::future<bool>> m_copyFuture;
+        std::shared_ptr<ContentImportProgress> m_importProgress;
     };
 };
\ No newline at end of file
@@ -2,15 +2,15 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> PlaceholderAsset::s_smptePipeline;
+    PendingPipeline PlaceholderAsset::s_smptePipeline;
 
     PlaceholderAsset::PlaceholderAsset() {
         AssetBase::Initialize();
 
-        if (!s_smptePipeline.has_value()) {
-            s_smptePipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "smpte_pattern/shader")
+        if (!s_smptePipeline.IsRequested()) {
+            s_smptePipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "smpte_pattern/shader")
             );
         }
 
@@ -24,11 +24,12 @@ namespace Raster {
     }
 
     std::optional<Texture> PlaceholderAsset::AbstractGetPreviewTexture() {
-        if (s_smptePipeline.has_value() && (!m_texture.has_value() || (m_texture.has_value() && (m_texture.value().width != m_resolution.x || m_texture.value().height != m_resolution.y)))) {
+        auto pipelineCandidate = s_smptePipeline.Get();
+        if (pipelineCandidate.has_value() && (!m_texture.has_value() || (m_texture.has_value() && (m_texture.value().width != m_resolution.x || m_texture.value().height != m_resolution.y)))) {
             if (m_texture.has_value()) {
                 GPU::DestroyTexture(m_texture.value());
             }
-            auto& pipeline = s_smptePipeline.value();
+            auto& pipeline = pipelineCandidate.value();
 
             Texture smpteTexture = GPU::GenerateTexture(m_resolution.x, m_resolution.y, 3, TexturePrecision::Usual);
             Framebuffer smpteFramebuffer = GPU::GenerateFramebuffer(m_resolution.x, m_resolution.y, {smpteTexture});
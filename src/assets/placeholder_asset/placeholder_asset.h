@@ -2,6 +2,7 @@
 
 #include "common/assets.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "../../ImGui/imgui.h"
 #include "font/font.h"
 
@@ -26,6 +27,6 @@ namespace Raster {
 
         glm::vec2 m_resolution;
 
-        static std::optional<Pipeline> s_smptePipeline;
+        static PendingPipeline s_smptePipeline;
     };
 };
\ No newline at end of file
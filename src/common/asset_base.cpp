@@ -28,6 +28,10 @@ namespace Raster {
         return AbstractIsReady();
     }
 
+    bool AssetBase::IsLoading() {
+        return AbstractIsLoading();
+    }
+
     void AssetBase::Import(std::string t_path) {
         AbstractImport(t_path);
     }
@@ -35,6 +39,14 @@ namespace Raster {
     std::optional<Texture> AssetBase::GetPreviewTexture() {
         return AbstractGetPreviewTexture();
     }
+
+    std::optional<Texture> AssetBase::GetFrameTexture(float t_frame) {
+        return AbstractGetFrameTexture(t_frame);
+    }
+
+    std::optional<Texture> AssetBase::GetThumbnailTexture() {
+        return AbstractGetThumbnailTexture();
+    }
     
     std::optional<std::uintmax_t> AssetBase::GetSize() {
         return AbstractGetSize();
@@ -23,6 +23,11 @@ namespace Raster {
             s_implementations.push_back(implementation);
             std::cout << "loading asset '" << implementation.description.packageName << "'" << std::endl;
         }
+
+        // several assets may share extensions, keep the extension lookup order stable across platforms
+        std::sort(s_implementations.begin(), s_implementations.end(), [](const AssetImplementation& a, const AssetImplementation& b) {
+            return a.description.packageName < b.description.packageName;
+        });
     }
 
     std::optional<AbstractAsset> Assets::InstantiateAsset(std::string t_packageName) {
@@ -10,6 +10,8 @@ namespace Raster {
         this->name = "New Composition";
         this->description = "Empty Composition";
         this->blendMode = "";
+        this->cachedBlendMode = "";
+        this->cachedBlendModeIndex = -1;
         this->opacity = 1.0f;
         this->opacityAttributeID = -1;
         this->enabled = true;
@@ -23,6 +25,8 @@ namespace Raster {
         this->name = data["Name"];
         this->description = data["Description"];
         this->blendMode = data["BlendMode"];
+        this->cachedBlendMode = "";
+        this->cachedBlendModeIndex = -1;
         this->opacity = data["Opacity"];
         this->opacityAttributeID = data["OpacityAttributeID"];
         this->enabled = data["Enabled"];
@@ -3,15 +3,18 @@
 namespace Raster {
     Configuration::Configuration() {
         this->localizationCode = "en";
+        this->vramBudget = 2048;
     }
 
-    Configuration::Configuration(Json data) {
+    Configuration::Configuration(Json data) : Configuration() {
         this->localizationCode = data["Localization"];
+        if (data.contains("VRAMBudget")) this->vramBudget = data["VRAMBudget"];
     }
 
     Json Configuration::Serialize() {
         return {
-            {"Localization", this->localizationCode}
+            {"Localization", this->localizationCode},
+            {"VRAMBudget", this->vramBudget}
         };
     }
 };
\ No newline at end of file
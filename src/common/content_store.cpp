@@ -0,0 +1,307 @@
+#include "common/content_store.h"
+#include <cstring>
+
+#if defined(__linux__)
+    #include <linux/fs.h>
+    #include <sys/ioctl.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#elif defined(__APPLE__)
+    #include <sys/clonefile.h>
+#endif
+
+#define CONTENT_STORE_CHUNK_SIZE (16 * 1024 * 1024)
+
+namespace Raster {
+
+    std::string ContentStore::s_storeDirectory = "content_store";
+    std::mutex ContentStore::m_indexMutex;
+    std::optional<Json> ContentStore::m_index;
+
+    ContentImportProgress::ContentImportProgress() {
+        this->processedBytes = 0;
+        this->totalBytes = 0;
+        this->stage = ContentImportStage::Hashing;
+    }
+
+    float ContentImportProgress::GetPercentage() {
+        if (totalBytes == 0) return stage == ContentImportStage::Finished ? 1.0f : 0.0f;
+        return std::min((float) processedBytes / (float) totalBytes, 1.0f);
+    }
+
+    static uint64_t MixHash(uint64_t t_value) {
+        t_value ^= t_value >> 33;
+        t_value *= 0xff51afd7ed558ccdULL;
+        t_value ^= t_value >> 33;
+        t_value *= 0xc4ceb9fe1a85ec53ULL;
+        t_value ^= t_value >> 33;
+        return t_value;
+    }
+
+    // two independent 64-bit lanes over 8-byte words, seeded with the chunk index
+    static std::pair<uint64_t, uint64_t> HashChunk(const char* t_data, size_t t_size, uint64_t t_seed) {
+        uint64_t a = 0x9E3779B97F4A7C15ULL ^ t_seed;
+        uint64_t b = 0xC2B2AE3D27D4EB4FULL + t_seed;
+        size_t wordsCount = t_size / 8;
+        for (size_t i = 0; i < wordsCount; i++) {
+            uint64_t word;
+            std::memcpy(&word, t_data + i * 8, 8);
+            a = (a ^ word) * 0xff51afd7ed558ccdULL;
+            a ^= a >> 32;
+            b = (b + word) * 0xc4ceb9fe1a85ec53ULL;
+            b ^= b >> 29;
+        }
+        for (size_t i = wordsCount * 8; i < t_size; i++) {
+            a = (a ^ (uint8_t) t_data[i]) * 0xff51afd7ed558ccdULL;
+            b = (b + (uint8_t) t_data[i]) * 0xc4ceb9fe1a85ec53ULL;
+        }
+        return {MixHash(a ^ t_size), MixHash(b + t_size)};
+    }
+
+    std::string ContentStore::GetIndexKey(std::string t_path) {
+        std::error_code errorCode;
+        auto canonicalPath = std::filesystem::weakly_canonical(t_path, errorCode);
+        auto size = std::filesystem::file_size(t_path, errorCode);
+        auto writeTime = std::filesystem::last_write_time(t_path, errorCode).time_since_epoch().count();
+        return FormatString("%s|%llu|%lld", canonicalPath.string().c_str(), (unsigned long long) size, (long long) writeTime);
+    }
+
+    void ContentStore::LoadIndex() {
+        if (m_index.has_value()) return;
+        std::string indexPath = FormatString("%s/index.json", s_storeDirectory.c_str());
+        m_index = Json::object();
+        if (std::filesystem::exists(indexPath)) {
+            try {
+                m_index = Json::parse(ReadFile(indexPath));
+            } catch (...) {
+                print("content store index is corrupted, starting from scratch");
+            }
+        }
+        // indices written before references were tracked only hold the hashes
+        auto& index = m_index.value();
+        if (!index.contains("Hashes")) {
+            index = {
+                {"Hashes", index},
+                {"References", Json::object()}
+            };
+        }
+    }
+
+    void ContentStore::SaveIndex() {
+        if (!m_index.has_value()) return;
+        std::error_code errorCode;
+        std::filesystem::create_directories(s_storeDirectory, errorCode);
+        try {
+            WriteFile(FormatString("%s/index.json", s_storeDirectory.c_str()), m_index.value().dump());
+        } catch (...) {
+            print("failed to save content store index");
+        }
+    }
+
+    std::optional<std::string> ContentStore::HashFile(std::string t_path, std::shared_ptr<ContentImportProgress> t_progress) {
+        if (!std::filesystem::exists(t_path) || std::filesystem::is_directory(t_path)) return std::nullopt;
+
+        std::string indexKey = GetIndexKey(t_path);
+        std::uintmax_t fileSize = std::filesystem::file_size(t_path);
+        if (t_progress) {
+            t_progress->totalBytes = fileSize;
+            t_progress->stage = ContentImportStage::Hashing;
+        }
+        {
+            std::lock_guard<std::mutex> lg(m_indexMutex);
+            LoadIndex();
+            auto& hashes = m_index.value()["Hashes"];
+            if (hashes.contains(indexKey)) {
+                if (t_progress) t_progress->processedBytes = fileSize;
+                return hashes[indexKey].get<std::string>();
+            }
+        }
+
+        // chunks are hashed independently by several threads and combined in order afterwards
+        size_t chunksCount = std::max((size_t) ((fileSize + CONTENT_STORE_CHUNK_SIZE - 1) / CONTENT_STORE_CHUNK_SIZE), (size_t) 1);
+        std::vector<std::pair<uint64_t, uint64_t>> chunkHashes(chunksCount);
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<bool> failed = false;
+
+        size_t threadsCount = std::clamp((size_t) std::thread::hardware_concurrency(), (size_t) 1, chunksCount);
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < threadsCount; i++) {
+            workers.push_back(std::thread([&]() {
+                std::ifstream stream(t_path, std::ios::binary);
+                if (!stream.is_open()) {
+                    failed = true;
+                    return;
+                }
+                std::vector<char> buffer(CONTENT_STORE_CHUNK_SIZE);
+                while (!failed) {
+                    size_t chunk = nextChunk++;
+                    if (chunk >= chunksCount) break;
+                    stream.clear();
+                    stream.seekg((std::streamoff) chunk * CONTENT_STORE_CHUNK_SIZE);
+                    stream.read(buffer.data(), buffer.size());
+                    std::streamsize readCount = stream.gcount();
+                    if (readCount <= 0 && fileSize > 0) {
+                        failed = true;
+                        break;
+                    }
+                    chunkHashes[chunk] = HashChunk(buffer.data(), (size_t) readCount, chunk);
+                    if (t_progress) t_progress->processedBytes += readCount;
+                }
+            }));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (failed) return std::nullopt;
+
+        uint64_t a = fileSize, b = ~fileSize;
+        for (auto& chunkHash : chunkHashes) {
+            a = MixHash(a ^ chunkHash.first);
+            b = MixHash(b + chunkHash.second);
+        }
+        std::string hash = FormatString("%016llx%016llx", (unsigned long long) a, (unsigned long long) b);
+
+        {
+            std::lock_guard<std::mutex> lg(m_indexMutex);
+            m_index.value()["Hashes"][indexKey] = hash;
+            SaveIndex();
+        }
+        return hash;
+    }
+
+    bool ContentStore::Import(std::string t_sourcePath, std::string t_destinationPath, std::shared_ptr<ContentImportProgress> t_progress) {
+        auto hashCandidate = HashFile(t_sourcePath, t_progress);
+        if (!hashCandidate.has_value()) {
+            if (t_progress) t_progress->stage = ContentImportStage::Failed;
+            return false;
+        }
+        if (t_progress) t_progress->stage = ContentImportStage::Linking;
+
+        std::string objectsDirectory = FormatString("%s/objects", s_storeDirectory.c_str());
+        std::string objectName = hashCandidate.value() + std::filesystem::path(t_sourcePath).extension().string();
+        std::string objectPath = FormatString("%s/%s", objectsDirectory.c_str(), objectName.c_str());
+        std::error_code errorCode;
+        std::filesystem::create_directories(objectsDirectory, errorCode);
+
+        // the original is never hardlinked into the store, editing it in place would silently change every project.
+        // Without reflinks the store keeps one full copy, every further import of the same content is linked for free
+        bool objectAvailable = std::filesystem::exists(objectPath);
+        if (!objectAvailable) {
+            objectAvailable = TryReflink(t_sourcePath, objectPath);
+            if (!objectAvailable) {
+                if (t_progress) t_progress->stage = ContentImportStage::Copying;
+                std::string temporaryPath = objectPath + ".tmp";
+                std::filesystem::copy_file(t_sourcePath, temporaryPath, std::filesystem::copy_options::overwrite_existing, errorCode);
+                if (!errorCode) std::filesystem::rename(temporaryPath, objectPath, errorCode);
+                objectAvailable = !errorCode;
+            }
+        }
+
+        if (t_progress) t_progress->stage = ContentImportStage::Linking;
+        bool success = LinkOrCopy(objectAvailable ? objectPath : t_sourcePath, t_destinationPath);
+        if (success && objectAvailable) {
+            std::lock_guard<std::mutex> lg(m_indexMutex);
+            LoadIndex();
+            auto& references = m_index.value()["References"][objectName];
+            std::string destinationPath = std::filesystem::weakly_canonical(t_destinationPath, errorCode).string();
+            if (std::find(references.begin(), references.end(), destinationPath) == references.end()) {
+                references.push_back(destinationPath);
+            }
+            SaveIndex();
+        }
+        if (t_progress) {
+            t_progress->processedBytes = t_progress->totalBytes.load();
+            t_progress->stage = success ? ContentImportStage::Finished : ContentImportStage::Failed;
+        }
+        return success;
+    }
+
+    void ContentStore::Release(std::string t_destinationPath) {
+        std::error_code errorCode;
+        std::string destinationPath = std::filesystem::weakly_canonical(t_destinationPath, errorCode).string();
+
+        std::lock_guard<std::mutex> lg(m_indexMutex);
+        LoadIndex();
+        std::vector<std::string> releasedObjects;
+        for (auto& [object, references] : m_index.value()["References"].items()) {
+            auto iterator = std::find(references.begin(), references.end(), destinationPath);
+            if (iterator == references.end()) continue;
+            references.erase(iterator);
+            if (references.empty()) releasedObjects.push_back(object);
+        }
+        for (auto& object : releasedObjects) {
+            CollectObject(object);
+        }
+        SaveIndex();
+    }
+
+    void ContentStore::CollectGarbage() {
+        std::lock_guard<std::mutex> lg(m_indexMutex);
+        LoadIndex();
+        std::vector<std::string> unusedObjects;
+        for (auto& [object, references] : m_index.value()["References"].items()) {
+            Json existingReferences = Json::array();
+            for (auto& reference : references) {
+                if (std::filesystem::exists(reference.get<std::string>())) existingReferences.push_back(reference);
+            }
+            references = existingReferences;
+            if (references.empty()) unusedObjects.push_back(object);
+        }
+        for (auto& object : unusedObjects) {
+            CollectObject(object);
+        }
+        SaveIndex();
+    }
+
+    void ContentStore::CollectObject(std::string t_object) {
+        auto& index = m_index.value();
+        index["References"].erase(t_object);
+
+        std::error_code errorCode;
+        std::filesystem::remove(FormatString("%s/objects/%s", s_storeDirectory.c_str(), t_object.c_str()), errorCode);
+
+        // cached hashes of the content would point to an object that no longer exists
+        std::string hash = std::filesystem::path(t_object).stem().string();
+        auto& hashes = index["Hashes"];
+        for (auto iterator = hashes.begin(); iterator != hashes.end();) {
+            if (iterator.value().get<std::string>() == hash) {
+                iterator = hashes.erase(iterator);
+            } else {
+                iterator++;
+            }
+        }
+    }
+
+    bool ContentStore::LinkOrCopy(std::string t_sourcePath, std::string t_destinationPath) {
+        if (TryReflink(t_sourcePath, t_destinationPath)) return true;
+
+        std::error_code errorCode;
+        std::filesystem::create_hard_link(t_sourcePath, t_destinationPath, errorCode);
+        if (!errorCode) return true;
+
+        errorCode.clear();
+        std::filesystem::copy_file(t_sourcePath, t_destinationPath, std::filesystem::copy_options::overwrite_existing, errorCode);
+        return !errorCode;
+    }
+
+    bool ContentStore::TryReflink(std::string t_sourcePath, std::string t_destinationPath) {
+#if defined(__linux__)
+        int sourceDescriptor = open(t_sourcePath.c_str(), O_RDONLY);
+        if (sourceDescriptor < 0) return false;
+        int destinationDescriptor = open(t_destinationPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (destinationDescriptor < 0) {
+            close(sourceDescriptor);
+            return false;
+        }
+        bool success = ioctl(destinationDescriptor, FICLONE, sourceDescriptor) == 0;
+        close(destinationDescriptor);
+        close(sourceDescriptor);
+        if (!success) unlink(t_destinationPath.c_str());
+        return success;
+#elif defined(__APPLE__)
+        return clonefile(t_sourcePath.c_str(), t_destinationPath.c_str(), 0) == 0;
+#else
+        return false;
+#endif
+    }
+};
\ No newline at end of file
@@ -14,6 +14,7 @@ namespace Raster {
     OverlayDispatchersCollection Dispatchers::s_overlayDispatchers;
 
     bool Dispatchers::s_enableOverlays = true;
+    int Dispatchers::s_previewAttachment = 0;
 
 
     void Dispatchers::DispatchProperty(NodeBase* t_owner, std::string t_attribute, std::any& t_value, bool t_isAttributeExposed) {
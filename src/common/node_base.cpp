@@ -21,6 +21,8 @@ namespace Raster {
         {TYPE_NAME(ICON_FA_IMAGE, SamplerSettings), SamplerSettings()}
     };
 
+    float NodeBase::s_executionResolutionScale = 1.0f;
+
     void NodeBase::SetAttributeValue(std::string t_attribute, std::any t_value) {
         this->m_attributes[t_attribute] = t_value;
     }
@@ -33,6 +35,7 @@ namespace Raster {
     void NodeBase::Initialize() {
         this->enabled = true;
         this->bypassed = false;
+        this->resolutionScale = 1.0f;
         this->executionsPerFrame = 0;
     }
 
@@ -52,7 +55,7 @@ namespace Raster {
         }
         Workspace::UpdatePinCache(t_accumulator);
         executionsPerFrame++;
-        auto pinMap = AbstractExecute(t_accumulator);
+        auto pinMap = ScaledAbstractExecute(t_accumulator);
         Workspace::UpdatePinCache(pinMap);
         auto outputPin = flowOutputPin.value_or(GenericPin());
         if (outputPin.connectedPinID > 0) {
@@ -198,6 +201,26 @@ namespace Raster {
         }
     }
 
+    AbstractPinMap NodeBase::ScaledAbstractExecute(AbstractPinMap t_accumulator) {
+        // inputs pulled during the execution restore the scale of this node when they return
+        float previousScale = s_executionResolutionScale;
+        s_executionResolutionScale = resolutionScale;
+        auto pinMap = AbstractExecute(t_accumulator);
+        s_executionResolutionScale = previousScale;
+
+        if (resolutionScale < 1.0f) {
+            for (auto& [pinID, value] : pinMap) {
+                if (value.type() != typeid(Framebuffer)) continue;
+                // bounds are in pixels of the smaller target, consumers treat the whole framebuffer as written instead
+                auto framebuffer = std::any_cast<Framebuffer>(value);
+                framebuffer.bounds = std::nullopt;
+                framebuffer.opaque = false;
+                value = framebuffer;
+            }
+        }
+        return pinMap;
+    }
+
     std::string NodeBase::Header() {
         if (!overridenHeader.empty()) {
             return overridenHeader;
@@ -231,6 +254,7 @@ namespace Raster {
 
         data["Enabled"] = enabled;
         data["Bypassed"] = bypassed;
+        data["ResolutionScale"] = resolutionScale;
 
         return data;
     }
@@ -261,7 +285,7 @@ namespace Raster {
 
         auto targetNode = Workspace::GetNodeByPinID(attributePin.connectedPinID);
         if (targetNode.has_value() && targetNode.value()->enabled) {
-            auto pinMap = targetNode.value()->AbstractExecute();
+            auto pinMap = targetNode.value()->ScaledAbstractExecute();
             Workspace::UpdatePinCache(pinMap);
             auto dynamicAttribute = pinMap[attributePin.connectedPinID];
             targetNode.value()->executionsPerFrame++;
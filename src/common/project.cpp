@@ -70,7 +70,15 @@ namespace Raster {
 
     glm::mat4 Project::GetProjectionMatrix(bool invert) {
         float aspect = preferredResolution.x / preferredResolution.y;
-        return glm::ortho(-aspect, aspect, 1.0f * (invert ? -1 : 1), -1.0f * (invert ? -1 : 1), -1.0f, 1.0f);
+        auto projection = glm::ortho(-aspect, aspect, 1.0f * (invert ? -1 : 1), -1.0f * (invert ? -1 : 1), -1.0f, 1.0f);
+        if (renderRegion.has_value() && !invert) {
+            // stretches the region's part of the NDC cube over the whole framebuffer
+            auto& region = renderRegion.value();
+            glm::vec2 center = (glm::vec2(region.x, region.y) + glm::vec2(region.z, region.w) * 0.5f) * 2.0f - 1.0f;
+            auto crop = glm::scale(glm::mat4(1), glm::vec3(1.0f / region.z, 1.0f / region.w, 1.0f)) * glm::translate(glm::mat4(1), glm::vec3(-center, 0.0f));
+            projection = crop * projection;
+        }
+        return projection;
     }
 
     float Project::GetCorrectCurrentTime() {
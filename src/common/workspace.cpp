@@ -181,6 +181,9 @@ namespace Raster {
                 node->libraryName = nodeImplementation.value().libraryName;
                 node->enabled = data["Enabled"];
                 node->bypassed = data["Bypassed"];
+                if (data.contains("ResolutionScale")) {
+                    node->resolutionScale = glm::clamp((float) data["ResolutionScale"], 0.25f, 1.0f);
+                }
                 if (data.contains("NodeData") && !data["NodeData"].is_null()) {
                     node->AbstractLoadSerialized(data["NodeData"]);
                 }
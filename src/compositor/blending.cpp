@@ -32,30 +32,40 @@ namespace Raster {
     }
 
     void Blending::GenerateBlendingPipeline() {
-        std::string accumulatedFunctions = "\n";
-        std::string accumulatedCode = "\n";
-        int modeIndex = 0;
-        for (auto& mode : modes) {
-            accumulatedCode += FormatString("\tif (uBlendMode == %i) return (%s);\n", modeIndex, mode.formula.c_str());
-            std::string functionsPath = GPU::GetShadersPath() + mode.functions + ".frag";
-            if (std::filesystem::exists(functionsPath)) {
-                accumulatedFunctions += "\n" + ReadFile(functionsPath) + "\n";
-            }
-            modeIndex++;
+        codeBase = ReadFile(GPU::GetShadersPath() + "compositor/blending_base.frag");
+        vertexShaderCandidate = ShaderCompiler::RequestShader(ShaderType::Vertex, "compositor/blending");
+        for (int i = 0; i < (int) modes.size(); i++) {
+            RequestModePipeline(i);
         }
+    }
 
-        std::string codeBase = ReadFile(GPU::GetShadersPath() + "compositor/blending_base.frag");
-        codeBase = ReplaceString(codeBase, RASTER_BLENDING_PLACEHOLDER, accumulatedCode);
-        codeBase = ReplaceString(codeBase, RASTER_BLENDING_FUNCTIONS_PLACEHOLDER, accumulatedFunctions);
-        WriteFile(GPU::GetShadersPath() + "compositor/blending.frag", codeBase);
+    void Blending::RequestModePipeline(int t_modeIndex) {
+        auto& mode = modes[t_modeIndex];
+        std::string functions = "\n";
+        std::string functionsPath = GPU::GetShadersPath() + mode.functions + ".frag";
+        if (!mode.functions.empty() && std::filesystem::exists(functionsPath)) {
+            functions += ReadFile(functionsPath) + "\n";
+        }
 
-        pipelineCandidate = GPU::GeneratePipeline(
-            GPU::GenerateShader(ShaderType::Vertex, "compositor/blending"),
-            GPU::GenerateShader(ShaderType::Fragment, "compositor/blending")
+        std::string code = ReplaceString(codeBase, RASTER_BLENDING_PLACEHOLDER, FormatString("return (%s);", mode.formula.c_str()));
+        code = ReplaceString(code, RASTER_BLENDING_FUNCTIONS_PLACEHOLDER, functions);
+
+        pipelines[t_modeIndex] = ShaderCompiler::RequestPipeline(
+            vertexShaderCandidate.value(),
+            ShaderCompiler::RequestShaderFromSource(ShaderType::Fragment, "compositor/blending/" + mode.codename, code)
         );
     }
 
+    std::optional<Pipeline> Blending::GetModePipeline(int t_modeIndex) {
+        if (!vertexShaderCandidate.has_value() || t_modeIndex < 0 || t_modeIndex >= (int) modes.size()) return std::nullopt;
+        if (pipelines.find(t_modeIndex) == pipelines.end()) RequestModePipeline(t_modeIndex);
+        return pipelines[t_modeIndex].Get();
+    }
+
     Framebuffer Blending::PerformManualBlending(BlendingMode& mode, Texture base, Texture blend, float opacity, glm::vec4 backgroundColor) {
+        auto modeIndexCandidate = GetModeIndexByCodeName(mode.codename);
+        if (!modeIndexCandidate.has_value()) return Framebuffer{};
+        auto pipelineCandidate = GetModePipeline(modeIndexCandidate.value());
         if (!pipelineCandidate.has_value()) return Framebuffer{};
         EnsureResolutionConstraints(base);
 
@@ -65,7 +75,6 @@ namespace Raster {
         GPU::BindPipeline(pipeline);
         GPU::ClearFramebuffer(backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
         GPU::SetShaderUniform(pipeline.fragment, "uResolution", {base.width, base.height});
-        GPU::SetShaderUniform(pipeline.fragment, "uBlendMode", GetModeIndexByCodeName(mode.codename).value());
         GPU::SetShaderUniform(pipeline.fragment, "uOpacity", opacity);
 
         GPU::BindTextureToShader(pipeline.fragment, "uBase", base, 0);
@@ -75,6 +84,26 @@ namespace Raster {
         return framebuffer;
     }
 
+    void Blending::PerformFusedBlending(int t_modeIndex, Framebuffer& t_base, Texture t_blendColor, Texture t_blendUV, float t_opacity, Framebuffer& t_destination) {
+        auto pipelineCandidate = GetModePipeline(t_modeIndex);
+        if (!pipelineCandidate.has_value()) return;
+
+        auto& pipeline = pipelineCandidate.value();
+        GPU::BindFramebuffer(t_destination);
+        GPU::BindPipeline(pipeline);
+        // every pixel of the destination is overwritten, so no clear and no fixed-function blending is needed
+        GPU::SetBlendingEnabled(false);
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", {t_destination.width, t_destination.height});
+        GPU::SetShaderUniform(pipeline.fragment, "uOpacity", t_opacity);
+
+        GPU::BindTextureToShader(pipeline.fragment, "uBase", t_base.attachments[0], 0);
+        GPU::BindTextureToShader(pipeline.fragment, "uBlend", t_blendColor, 1);
+        GPU::BindTextureToShader(pipeline.fragment, "uBaseUV", t_base.attachments.size() > 1 ? t_base.attachments[1] : Texture(), 2);
+        GPU::BindTextureToShader(pipeline.fragment, "uBlendUV", t_blendUV, 3);
+        GPU::DrawArrays(3);
+        GPU::SetBlendingEnabled(true);
+    }
+
     Framebuffer Blending::PerformBlending(BlendingMode& mode, Texture base, Texture blend, float opacity) {
         return PerformManualBlending(mode, base, blend, opacity, glm::vec4(0, 0, 0, 1));
     }
@@ -90,9 +119,7 @@ namespace Raster {
 
         if (mustReinitialize) {
             if (framebufferCandidate.has_value()) {
-                auto& framebuffer = framebufferCandidate.value();
-                GPU::DestroyTexture(framebuffer.attachments[0]);
-                GPU::DestroyFramebuffer(framebuffer);
+                GPU::DestroyFramebufferWithAttachments(framebufferCandidate.value());
             }
 
             framebufferCandidate = GPU::GenerateFramebuffer(texture.width, texture.height, {
@@ -1,18 +1,42 @@
 #include "compositor/compositor.h"
+#include "compositor/content_bounds.h"
+#include "compositor/render_target_pool.h"
+#include "../ImGui/imgui.h"
 
 namespace Raster {
     std::optional<Framebuffer> Compositor::primaryFramebuffer;
     float Compositor::previewResolutionScale = 1.0f;
+    bool Compositor::s_adaptiveResolution = false;
+    float Compositor::s_adaptiveResolutionScale = 1.0f;
 
+    // a fixed set of steps keeps the number of distinct target sizes in the pools small
+    static std::vector<float> s_adaptiveResolutionSteps = {1.0f, 0.75f, 0.5f, 0.35f, 0.25f};
+    static int s_adaptiveResolutionStep = 0;
+    static int s_overBudgetFrames = 0;
+    static int s_underBudgetFrames = 0;
+    static float s_lastObservedFrame = -1.0f;
+    static float s_idleTime = 0.0f;
+
+    // uniforms of s_pipeline, set once per composited layer
+    static UniformHandle s_colorUniform, s_uvUniform, s_opacityUniform, s_resolutionUniform;
+    // pipeline the handles above were resolved for
+    static void* s_resolvedPipeline = nullptr;
+
+    // previously used primary framebuffers, adaptive resolution stepping back to a recent resolution doesn't reallocate.
+    // Empty while adaptive resolution is off
+    static std::vector<Framebuffer> s_primaryFramebufferCache;
+
+    std::optional<RenderTile> Compositor::s_renderTile;
+    glm::vec2 Compositor::s_samplingRadius = glm::vec2(0);
     std::unordered_map<int, RenderableBundle> Compositor::s_bundles;
     std::vector<CompositorTarget> Compositor::s_targets;
     Blending Compositor::s_blending;
-    Pipeline Compositor::s_pipeline;
+    PendingPipeline Compositor::s_pipeline;
 
     void Compositor::Initialize() {
-        s_pipeline = GPU::GeneratePipeline(
-            GPU::GenerateShader(ShaderType::Vertex, "compositor/shader"),
-            GPU::GenerateShader(ShaderType::Fragment, "compositor/shader")
+        s_pipeline = ShaderCompiler::RequestPipeline(
+            ShaderCompiler::RequestShader(ShaderType::Vertex, "compositor/shader"),
+            ShaderCompiler::RequestShader(ShaderType::Fragment, "compositor/shader")
         );
 
         s_blending = Blending(ReadJson("misc/blending.json"));
@@ -37,42 +61,133 @@ namespace Raster {
     }
 
     void Compositor::PerformManualComposition(std::vector<CompositorTarget> t_targets, Framebuffer& t_fbo, std::optional<glm::vec4> t_backgroundColor) {
-        auto& framebuffer = t_fbo;
-        GPU::BindFramebuffer(framebuffer);
-        GPU::BindPipeline(s_pipeline);
         auto& bg = t_backgroundColor.has_value() ? t_backgroundColor.value() : Workspace::s_project.value().backgroundColor;
+
+        // an opaque normal layer covering the whole framebuffer hides everything below it
+        int firstVisibleTarget = 0;
+        for (int i = 0; i < (int) t_targets.size(); i++) {
+            auto& target = t_targets[i];
+            if (target.blendModeIndex < 0 && target.opacity >= 1.0f && target.opaque && ContentBounds::CoversFramebuffer(target.bounds, t_fbo)) {
+                firstVisibleTarget = i;
+            }
+        }
+
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && s_resolvedPipeline != pipelineCandidate.value().handle) {
+            auto& pipeline = pipelineCandidate.value();
+            s_colorUniform = GPU::GetUniformHandle(pipeline.fragment, "uColor");
+            s_uvUniform = GPU::GetUniformHandle(pipeline.fragment, "uUV");
+            s_opacityUniform = GPU::GetUniformHandle(pipeline.fragment, "uOpacity");
+            s_resolutionUniform = GPU::GetUniformHandle(pipeline.fragment, "uResolution");
+            s_resolvedPipeline = pipeline.handle;
+        }
+
+        // fully transparent layers leave the result untouched whatever their blend mode is,
+        // layers whose programs are still compiling are left out until they are ready
+        std::vector<CompositorTarget> visibleTargets;
+        for (int i = firstVisibleTarget; i < (int) t_targets.size(); i++) {
+            auto& target = t_targets[i];
+            if (target.opacity <= 0.0f || ContentBounds::IsEmpty(target.bounds)) continue;
+            bool pipelineReady = target.blendModeIndex < 0 ? pipelineCandidate.has_value() : s_blending.GetModePipeline(target.blendModeIndex).has_value();
+            if (!pipelineReady) continue;
+            if (target.bounds.has_value()) target.bounds = ContentBounds::Clamp(target.bounds.value(), t_fbo);
+            visibleTargets.push_back(target);
+        }
+
+        // only blend mode layers covering the whole framebuffer swap the ping-pong pair, smaller ones are
+        // blended into the other framebuffer under a scissor and copied back
+        int blendedTargetsCount = 0;
+        int swappingTargetsCount = 0;
+        for (auto& target : visibleTargets) {
+            if (target.blendModeIndex < 0) continue;
+            blendedTargetsCount++;
+            if (ContentBounds::CoversFramebuffer(target.bounds, t_fbo)) swappingTargetsCount++;
+        }
+
+        // every swap exchanges the pair once, starting in the right buffer
+        // makes the last blended layer land in t_fbo without any extra copy
+        Framebuffer* current = &t_fbo;
+        Framebuffer* other = &t_fbo;
+        // ping-pong partner of t_fbo, callers composite at different sizes (primary framebuffer, Merge, timeline
+        // preview, tiles), so it comes from the pool instead of one shared framebuffer reallocated between them.
+        // The pair is swapped, so it mirrors the attachments of t_fbo
+        std::optional<Framebuffer> accumulationFramebufferCandidate;
+        if (blendedTargetsCount > 0) {
+            TexturePrecision precision = t_fbo.attachments.empty() ? TexturePrecision::Usual : t_fbo.attachments[0].precision;
+            accumulationFramebufferCandidate = RenderTargetPool::Acquire({t_fbo.width, t_fbo.height}, precision, (int) t_fbo.attachments.size());
+            auto& accumulationFramebuffer = accumulationFramebufferCandidate.value();
+            current = swappingTargetsCount % 2 == 0 ? &t_fbo : &accumulationFramebuffer;
+            other = swappingTargetsCount % 2 == 0 ? &accumulationFramebuffer : &t_fbo;
+        }
+
+        GPU::BindFramebuffer(*current);
         GPU::ClearFramebuffer(bg.r, bg.g, bg.b, bg.a);
-        for (auto& target : t_targets) {
-            auto blendingModeCandidate = s_blending.GetModeByCodeName(target.blendMode);
-            if (blendingModeCandidate.has_value()) {
-                auto& blendingMode = blendingModeCandidate.value();
-                auto blendedResult = s_blending.PerformManualBlending(blendingMode, framebuffer.attachments[0], target.colorAttachment, target.opacity, bg);
-                GPU::BindFramebuffer(framebuffer);
-                GPU::BindPipeline(s_pipeline);
-                GPU::BindTextureToShader(s_pipeline.fragment, "uColor", blendedResult.attachments[0], 0);
-                GPU::BindTextureToShader(s_pipeline.fragment, "uUV", target.uvAttachment, 1);
-                GPU::SetShaderUniform(s_pipeline.fragment, "uResolution", {framebuffer.width, framebuffer.height});
-                GPU::SetShaderUniform(s_pipeline.fragment, "uOpacity", 1.0f);
-                GPU::DrawArrays(3);
+        for (auto& target : visibleTargets) {
+            bool coversFramebuffer = ContentBounds::CoversFramebuffer(target.bounds, t_fbo);
+            GPU::SetScissor(coversFramebuffer ? std::nullopt : target.bounds);
+            if (target.blendModeIndex >= 0) {
+                s_blending.PerformFusedBlending(target.blendModeIndex, *current, target.colorAttachment, target.uvAttachment, target.opacity, *other);
+                if (coversFramebuffer) {
+                    std::swap(current, other);
+                } else {
+                    for (int i = 0; i < (int) other->attachments.size(); i++) {
+                        GPU::BlitFramebuffer(*current, other->attachments[i], i, target.bounds);
+                    }
+                }
             } else {
-                GPU::BindTextureToShader(s_pipeline.fragment, "uColor", target.colorAttachment, 0);
-                GPU::BindTextureToShader(s_pipeline.fragment, "uUV", target.uvAttachment, 1);
-                GPU::SetShaderUniform(s_pipeline.fragment, "uOpacity", target.opacity);
-                GPU::SetShaderUniform(s_pipeline.fragment, "uResolution", {framebuffer.width, framebuffer.height});
+                GPU::BindFramebuffer(*current);
+                GPU::BindPipeline(pipelineCandidate.value());
+                GPU::BindTextureToShader(s_colorUniform, target.colorAttachment, 0);
+                GPU::BindTextureToShader(s_uvUniform, target.uvAttachment, 1);
+                GPU::SetShaderUniform(s_opacityUniform, target.opacity);
+                GPU::SetShaderUniform(s_resolutionUniform, glm::vec2(current->width, current->height));
                 GPU::DrawArrays(3);
             }
         }
+        GPU::SetScissor(std::nullopt);
+        GPU::BindFramebuffer(t_fbo);
+        // the last blended layer landed in t_fbo, the partner holds nothing worth keeping
+        if (accumulationFramebufferCandidate.has_value()) {
+            RenderTargetPool::Release(accumulationFramebufferCandidate.value());
+        }
+    }
+
+    static void FlushPrimaryFramebufferCache() {
+        for (auto& framebuffer : s_primaryFramebufferCache) {
+            GPU::DestroyFramebufferWithAttachments(framebuffer);
+        }
+        s_primaryFramebufferCache.clear();
     }
 
     void Compositor::ResizePrimaryFramebuffer(glm::vec2 t_resolution) {
+        // previous resolutions are only worth keeping while adaptive resolution steps back and forth between them,
+        // a manual scale change would otherwise leave full-size framebuffers behind
         if (primaryFramebuffer.has_value()) {
-            auto& framebuffer = primaryFramebuffer.value();
-            GPU::DestroyTexture(framebuffer.attachments[0]);
-            GPU::DestroyFramebuffer(framebuffer);
+            if (s_adaptiveResolution) {
+                s_primaryFramebufferCache.insert(s_primaryFramebufferCache.begin(), primaryFramebuffer.value());
+            } else GPU::DestroyFramebufferWithAttachments(primaryFramebuffer.value());
+            primaryFramebuffer = std::nullopt;
+        }
+        if (!s_adaptiveResolution) FlushPrimaryFramebufferCache();
+
+        for (int i = 0; i < (int) s_primaryFramebufferCache.size(); i++) {
+            auto& framebuffer = s_primaryFramebufferCache[i];
+            if (IsCompatibleFramebuffer(framebuffer, t_resolution)) {
+                primaryFramebuffer = framebuffer;
+                s_primaryFramebufferCache.erase(s_primaryFramebufferCache.begin() + i);
+                break;
+            }
+        }
+
+        while (s_primaryFramebufferCache.size() >= s_adaptiveResolutionSteps.size()) {
+            GPU::DestroyFramebufferWithAttachments(s_primaryFramebufferCache.back());
+            s_primaryFramebufferCache.pop_back();
         }
 
-        primaryFramebuffer = GenerateCompatibleFramebuffer(t_resolution);
-        std::cout << "resized primary framebuffer " << t_resolution.x << "x" << t_resolution.y << std::endl;
+        if (!primaryFramebuffer.has_value()) {
+            primaryFramebuffer = GenerateCompatibleFramebuffer(t_resolution);
+            std::cout << "resized primary framebuffer " << t_resolution.x << "x" << t_resolution.y << std::endl;
+        }
     }
 
     void Compositor::EnsureResolutionConstraints() {
@@ -82,18 +197,25 @@ namespace Raster {
             }
             auto requiredResolution = GetRequiredResolution();
             auto framebuffer = primaryFramebuffer.value();
-            if (requiredResolution.x != framebuffer.width || requiredResolution.y != framebuffer.height) {
+            if (!IsCompatibleFramebuffer(framebuffer, requiredResolution)) {
                 ResizePrimaryFramebuffer(requiredResolution);
             }
             s_targets.clear();
+            s_samplingRadius = glm::vec2(0);
         }        
     }
 
-    Framebuffer Compositor::GenerateCompatibleFramebuffer(glm::vec2 t_resolution) {
-        return GPU::GenerateFramebuffer(t_resolution.x, t_resolution.y, std::vector<Texture>{
-            GPU::GenerateTexture(t_resolution.x, t_resolution.y, 4, TexturePrecision::Usual),
-            GPU::GenerateTexture(t_resolution.x, t_resolution.y, 4, TexturePrecision::Usual)
-        });
+    Framebuffer Compositor::GenerateCompatibleFramebuffer(glm::vec2 t_resolution, TexturePrecision t_precision) {
+        GPUMemoryOwnerScope ownerScope(GPUMemoryOwner::Compositor);
+        std::vector<Texture> attachments;
+        for (int i = 0; i < RenderTargetPool::GetCompatibleAttachmentsCount(); i++) {
+            attachments.push_back(GPU::GenerateTexture(t_resolution.x, t_resolution.y, 4, t_precision));
+        }
+        return GPU::GenerateFramebuffer(t_resolution.x, t_resolution.y, attachments);
+    }
+
+    bool Compositor::IsCompatibleFramebuffer(Framebuffer& t_fbo, glm::vec2 t_resolution) {
+        return t_fbo.width == t_resolution.x && t_fbo.height == t_resolution.y && (int) t_fbo.attachments.size() == RenderTargetPool::GetCompatibleAttachmentsCount();
     }
 
     void Compositor::EnsureResolutionConstraintsForFramebuffer(Framebuffer& t_fbo) {
@@ -102,20 +224,110 @@ namespace Raster {
             t_fbo = GenerateCompatibleFramebuffer(requiredResolution);
             return;
         }
-        if (t_fbo.width != requiredResolution.x || t_fbo.height != requiredResolution.y) {
-            for (auto& attachment : t_fbo.attachments) {
-                GPU::DestroyTexture(attachment);
-            }
-            GPU::DestroyFramebuffer(t_fbo);
+        if (!IsCompatibleFramebuffer(t_fbo, requiredResolution)) {
+            GPU::DestroyFramebufferWithAttachments(t_fbo);
             t_fbo = GenerateCompatibleFramebuffer(requiredResolution);
         }
     }
 
-    glm::vec2 Compositor::GetRequiredResolution() {
+    int Compositor::GetBlendModeIndex(Composition* t_composition) {
+        if (t_composition->cachedBlendMode != t_composition->blendMode) {
+            t_composition->cachedBlendMode = t_composition->blendMode;
+            t_composition->cachedBlendModeIndex = s_blending.GetModeIndexByCodeName(t_composition->blendMode).value_or(-1);
+        }
+        return t_composition->cachedBlendModeIndex;
+    }
+
+    // nodes rendering at a fraction of the resolution get proportionally smaller targets
+    static glm::vec2 ApplyNodeResolutionScale(glm::vec2 t_resolution) {
+        if (NodeBase::s_executionResolutionScale >= 1.0f) return t_resolution;
+        return glm::max(glm::trunc(t_resolution * NodeBase::s_executionResolutionScale), glm::vec2(1));
+    }
+
+    static glm::vec2 GetPreviewResolution() {
         if (Workspace::s_project.has_value()) {
             auto& project = Workspace::s_project.value();
-            return glm::trunc(project.preferredResolution * previewResolutionScale);
+            float scale = Compositor::previewResolutionScale;
+            if (Compositor::s_adaptiveResolution) scale = std::min(scale, Compositor::s_adaptiveResolutionScale);
+            return glm::max(glm::trunc(project.preferredResolution * scale), glm::vec2(1));
+        }
+        return glm::vec2();
+    }
+
+    glm::vec2 Compositor::GetRequiredResolution() {
+        if (s_renderTile.has_value()) {
+            auto& tile = s_renderTile.value();
+            return ApplyNodeResolutionScale(glm::vec2(tile.region.z, tile.region.w));
+        }
+        if (Workspace::s_project.has_value()) {
+            return ApplyNodeResolutionScale(GetPreviewResolution());
         }
         return glm::vec2();
     }
+
+    glm::vec2 Compositor::GetOutputResolution() {
+        if (s_renderTile.has_value()) return ApplyNodeResolutionScale(s_renderTile.value().outputResolution);
+        return GetRequiredResolution();
+    }
+
+    glm::vec2 Compositor::GetAssetResolution() {
+        if (s_renderTile.has_value()) return s_renderTile.value().outputResolution;
+        return GetPreviewResolution();
+    }
+
+    void Compositor::ReportSamplingRadius(glm::vec2 t_radius) {
+        // radii of scaled nodes are measured in their own, larger pixels
+        s_samplingRadius = glm::max(s_samplingRadius, glm::abs(t_radius) / NodeBase::s_executionResolutionScale);
+    }
+
+    void Compositor::UpdateAdaptiveResolution(float t_cpuTime) {
+        if (!Workspace::s_project.has_value()) return;
+        auto& project = Workspace::s_project.value();
+
+        // scrubbing counts as interactive for a short while after the last frame change
+        if (project.currentFrame != s_lastObservedFrame) {
+            s_lastObservedFrame = project.currentFrame;
+            s_idleTime = 0.0f;
+        } else s_idleTime += ImGui::GetIO().DeltaTime;
+        bool interactive = project.playing || s_idleTime < 0.5f;
+
+        if (!s_adaptiveResolution && !s_primaryFramebufferCache.empty()) {
+            FlushPrimaryFramebufferCache();
+        }
+
+        if (!s_adaptiveResolution || !interactive) {
+            s_adaptiveResolutionStep = 0;
+            s_adaptiveResolutionScale = 1.0f;
+            s_overBudgetFrames = s_underBudgetFrames = 0;
+            return;
+        }
+
+        float renderTime = std::max(t_cpuTime, GPU::GetLastTimerQueryResult().value_or(0.0f));
+        float budget = 1000.0f / std::max(project.framerate, 1.0f);
+
+        if (renderTime > budget * 0.9f) {
+            s_overBudgetFrames++;
+            s_underBudgetFrames = 0;
+        } else {
+            s_overBudgetFrames = 0;
+            // rendering cost scales with the pixel count, step up only if the next step would still fit comfortably
+            if (s_adaptiveResolutionStep > 0) {
+                float currentStep = s_adaptiveResolutionSteps[s_adaptiveResolutionStep];
+                float nextStep = s_adaptiveResolutionSteps[s_adaptiveResolutionStep - 1];
+                float predictedTime = renderTime * (nextStep * nextStep) / (currentStep * currentStep);
+                if (predictedTime < budget * 0.75f) s_underBudgetFrames++;
+                else s_underBudgetFrames = 0;
+            }
+        }
+
+        if (s_overBudgetFrames >= 5 && s_adaptiveResolutionStep + 1 < (int) s_adaptiveResolutionSteps.size()) {
+            s_adaptiveResolutionStep++;
+            s_overBudgetFrames = 0;
+        }
+        if (s_underBudgetFrames >= 30 && s_adaptiveResolutionStep > 0) {
+            s_adaptiveResolutionStep--;
+            s_underBudgetFrames = 0;
+        }
+        s_adaptiveResolutionScale = s_adaptiveResolutionSteps[s_adaptiveResolutionStep];
+    }
 };
@@ -0,0 +1,63 @@
+#include "compositor/content_bounds.h"
+
+namespace Raster {
+    glm::ivec4 ContentBounds::Empty() {
+        return glm::ivec4(0);
+    }
+
+    bool ContentBounds::IsEmpty(std::optional<glm::ivec4> t_bounds) {
+        if (!t_bounds.has_value()) return false;
+        auto& bounds = t_bounds.value();
+        return bounds.z <= 0 || bounds.w <= 0;
+    }
+
+    bool ContentBounds::CoversFramebuffer(std::optional<glm::ivec4> t_bounds, Framebuffer& t_framebuffer) {
+        if (!t_bounds.has_value()) return true;
+        auto& bounds = t_bounds.value();
+        return bounds.x <= 0 && bounds.y <= 0 && bounds.x + bounds.z >= (int) t_framebuffer.width && bounds.y + bounds.w >= (int) t_framebuffer.height;
+    }
+
+    std::optional<glm::ivec4> ContentBounds::Union(std::optional<glm::ivec4> t_a, std::optional<glm::ivec4> t_b) {
+        if (!t_a.has_value() || !t_b.has_value()) return std::nullopt;
+        if (IsEmpty(t_a)) return t_b;
+        if (IsEmpty(t_b)) return t_a;
+        auto& a = t_a.value();
+        auto& b = t_b.value();
+        int minX = std::min(a.x, b.x);
+        int minY = std::min(a.y, b.y);
+        int maxX = std::max(a.x + a.z, b.x + b.z);
+        int maxY = std::max(a.y + a.w, b.y + b.w);
+        return glm::ivec4(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    std::optional<glm::ivec4> ContentBounds::Expand(std::optional<glm::ivec4> t_bounds, glm::ivec2 t_padding, Framebuffer& t_framebuffer) {
+        if (!t_bounds.has_value()) return std::nullopt;
+        if (IsEmpty(t_bounds)) return t_bounds;
+        auto bounds = t_bounds.value();
+        t_padding = glm::abs(t_padding);
+        return Clamp(glm::ivec4(bounds.x - t_padding.x, bounds.y - t_padding.y, bounds.z + t_padding.x * 2, bounds.w + t_padding.y * 2), t_framebuffer);
+    }
+
+    glm::ivec4 ContentBounds::FromQuad(glm::mat4 t_matrix, Framebuffer& t_framebuffer) {
+        glm::vec2 minimum(std::numeric_limits<float>::max());
+        glm::vec2 maximum(std::numeric_limits<float>::lowest());
+        for (auto& corner : {glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(-1, 1), glm::vec2(1, 1)}) {
+            glm::vec4 ndc = t_matrix * glm::vec4(corner, 0, 1);
+            glm::vec2 screen = (glm::vec2(ndc) / ndc.w * 0.5f + 0.5f) * glm::vec2(t_framebuffer.width, t_framebuffer.height);
+            minimum = glm::min(minimum, screen);
+            maximum = glm::max(maximum, screen);
+        }
+        // one extra pixel on every side keeps the rectangle conservative under rasterization rules
+        glm::ivec2 from = glm::ivec2(glm::floor(minimum)) - 1;
+        glm::ivec2 to = glm::ivec2(glm::ceil(maximum)) + 1;
+        return Clamp(glm::ivec4(from, to - from), t_framebuffer);
+    }
+
+    glm::ivec4 ContentBounds::Clamp(glm::ivec4 t_bounds, Framebuffer& t_framebuffer) {
+        int minX = std::clamp(t_bounds.x, 0, (int) t_framebuffer.width);
+        int minY = std::clamp(t_bounds.y, 0, (int) t_framebuffer.height);
+        int maxX = std::clamp(t_bounds.x + t_bounds.z, 0, (int) t_framebuffer.width);
+        int maxY = std::clamp(t_bounds.y + t_bounds.w, 0, (int) t_framebuffer.height);
+        return glm::ivec4(minX, minY, std::max(maxX - minX, 0), std::max(maxY - minY, 0));
+    }
+};
@@ -1,4 +1,6 @@
 #include "compositor/managed_framebuffer.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
 
 namespace Raster {
     ManagedFramebuffer::ManagedFramebuffer() {
@@ -6,53 +8,43 @@ namespace Raster {
     }
 
     ManagedFramebuffer::~ManagedFramebuffer() {
-        if (m_internalFramebuffer.handle) {
-            DestroyInternalFramebuffer();
-        }
     }
 
     Framebuffer& ManagedFramebuffer::Get(std::optional<Framebuffer> t_framebuffer) {
-        auto requiredResolution = Compositor::GetRequiredResolution();
-        if (!m_internalFramebuffer.handle) {
-            InstantiateInternalFramebuffer(requiredResolution.x, requiredResolution.y);
-        }
-        EnsureResolutionConstraints();
-        GPU::BindFramebuffer(m_internalFramebuffer);
-        GPU::ClearFramebuffer(0, 0, 0, 0);
+        this->m_internalFramebuffer = RenderTargetPool::Acquire();
+        RenderTargetPool::ClearTarget(m_internalFramebuffer);
+        std::optional<glm::ivec4> bounds = ContentBounds::Empty();
+        bool opaque = false;
         if (t_framebuffer.has_value() && t_framebuffer.value().handle) {
             auto& framebuffer = t_framebuffer.value();
+            std::optional<glm::ivec4> region = std::nullopt;
+            // bases rendered at another resolution scale are upsampled, their bounds are dropped by NodeBase
+            bool resampled = framebuffer.handle && (framebuffer.width != m_internalFramebuffer.width || framebuffer.height != m_internalFramebuffer.height);
+            if (framebuffer.bounds.has_value() && !resampled) {
+                region = ContentBounds::Clamp(framebuffer.bounds.value(), m_internalFramebuffer);
+            }
             int index = 0;
             for (auto& attachment : framebuffer.attachments) {
-                GPU::BlitFramebuffer(m_internalFramebuffer, attachment, index);
+                // bases produced before the UV attachment was required have more attachments than the copy
+                if (index >= (int) m_internalFramebuffer.attachments.size()) break;
+                if (resampled) {
+                    GPU::ResampleFramebuffer(m_internalFramebuffer, framebuffer, index);
+                } else GPU::BlitFramebuffer(m_internalFramebuffer, attachment, index, region);
                 index++;
             }
+            bounds = region;
+            opaque = framebuffer.opaque;
+            // the base is copied, nothing reads it after this point
+            RenderTargetPool::Consume(framebuffer);
         }
+        // callers extend the bounds by whatever they draw on top
+        RenderTargetPool::SetContentBounds(m_internalFramebuffer, bounds, opaque);
+        GPU::BindFramebuffer(m_internalFramebuffer);
         return m_internalFramebuffer;
     }
 
     void ManagedFramebuffer::Destroy() {
-        if (m_internalFramebuffer.handle) {
-            DestroyInternalFramebuffer();
-        }
-    }
-
-    void ManagedFramebuffer::EnsureResolutionConstraints() {
-        auto requiredResolution = Compositor::GetRequiredResolution();
-        if (m_internalFramebuffer.handle && (m_internalFramebuffer.width != requiredResolution.x || m_internalFramebuffer.height != requiredResolution.y)) {
-            DestroyInternalFramebuffer();
-            InstantiateInternalFramebuffer(requiredResolution.x, requiredResolution.y);
-        }
-    }
-
-    void ManagedFramebuffer::DestroyInternalFramebuffer() {
-        for (auto& attachment : m_internalFramebuffer.attachments) {
-            GPU::DestroyTexture(attachment);
-        }
-        GPU::DestroyFramebuffer(m_internalFramebuffer);
+        // the target may still be referenced by the compositor, the pool reclaims it when the next frame begins
         this->m_internalFramebuffer = Framebuffer();
     }
-
-    void ManagedFramebuffer::InstantiateInternalFramebuffer(uint32_t width, uint32_t height) {
-        this->m_internalFramebuffer = Compositor::GenerateCompatibleFramebuffer({width, height});
-    }
-};
\ No newline at end of file
+};
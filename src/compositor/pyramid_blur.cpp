@@ -0,0 +1,97 @@
+#include "compositor/pyramid_blur.h"
+#include "compositor/render_target_pool.h"
+
+namespace Raster {
+    PendingPipeline PyramidBlur::s_downsamplePipeline;
+    PendingPipeline PyramidBlur::s_upsamplePipeline;
+
+    bool PyramidBlur::IsReady() {
+        if (!s_downsamplePipeline.IsRequested()) {
+            s_downsamplePipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "pyramid_downsample/shader")
+            );
+            s_upsamplePipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "pyramid_upsample/shader")
+            );
+        }
+        return s_downsamplePipeline.Get().has_value() && s_upsamplePipeline.Get().has_value();
+    }
+
+    int PyramidBlur::GetLevels(float t_radius, glm::vec2 t_resolution) {
+        // n levels with the default offset reach about 3 * 2^n pixels
+        int levels = 1;
+        while (levels < PYRAMID_BLUR_MAX_LEVELS && glm::abs(t_radius) > 3.0f * (float) (1 << levels)) {
+            levels++;
+        }
+        // no level may collapse below two pixels
+        float smallestSide = glm::min(t_resolution.x, t_resolution.y);
+        while (levels > 1 && smallestSide / (float) (1 << levels) < 2.0f) {
+            levels--;
+        }
+        return levels;
+    }
+
+    std::vector<Framebuffer> PyramidBlur::Downsample(Texture& t_source, int t_levels, float t_offset) {
+        std::vector<Framebuffer> chain;
+        auto pipelineCandidate = s_downsamplePipeline.Get();
+        if (!pipelineCandidate.has_value()) return chain;
+        auto& pipeline = pipelineCandidate.value();
+
+        glm::vec2 resolution = glm::vec2(t_source.width, t_source.height);
+        for (int i = 0; i < t_levels; i++) {
+            resolution = glm::max(glm::floor(resolution * 0.5f), glm::vec2(1));
+            auto level = RenderTargetPool::Acquire(resolution, TexturePrecision::Usual, 1);
+            Pass(pipeline, chain.empty() ? t_source : chain.back().attachments.at(0), level, t_offset);
+            chain.push_back(level);
+        }
+        return chain;
+    }
+
+    void PyramidBlur::Upsample(std::vector<Framebuffer>& t_chain, Framebuffer& t_target, float t_offset) {
+        auto pipelineCandidate = s_upsamplePipeline.Get();
+        if (!pipelineCandidate.has_value() || t_chain.empty()) return;
+        auto& pipeline = pipelineCandidate.value();
+
+        // every level is overwritten by the upsampled level below it, the chain ends up holding the blurred image
+        for (int i = (int) t_chain.size() - 1; i > 0; i--) {
+            Pass(pipeline, t_chain[i].attachments.at(0), t_chain[i - 1], t_offset);
+        }
+        Pass(pipeline, t_chain[0].attachments.at(0), t_target, t_offset);
+    }
+
+    void PyramidBlur::Release(std::vector<Framebuffer>& t_chain) {
+        for (auto& level : t_chain) {
+            RenderTargetPool::Release(level);
+        }
+        t_chain.clear();
+    }
+
+    void PyramidBlur::Blur(Texture& t_source, Framebuffer& t_target, float t_radius) {
+        int levels = GetLevels(t_radius, glm::vec2(t_source.width, t_source.height));
+        // spreading the taps further covers radii between two level counts and what the resolution limit cuts off
+        float offset = glm::clamp(glm::abs(t_radius) / (float) (1 << (levels + 1)), 0.0f, 4.0f);
+
+        auto chain = Downsample(t_source, levels, offset);
+        Upsample(chain, t_target, offset);
+        Release(chain);
+    }
+
+    void PyramidBlur::Pass(Pipeline& t_pipeline, Texture& t_source, Framebuffer& t_target, float t_offset) {
+        GPU::BindFramebuffer(t_target);
+        GPU::BindPipeline(t_pipeline);
+        // taps leaving the image repeat its edge instead of wrapping around to the opposite one
+        GPU::BindSampler(GPU::GetSampler(TextureWrappingMode::ClampToEdge, TextureFilteringMode::Linear), 0);
+        // every pixel of the target is overwritten
+        GPU::SetBlendingEnabled(false);
+
+        GPU::BindTextureToShader(t_pipeline.fragment, "uTexture", t_source, 0);
+        GPU::SetShaderUniform(t_pipeline.fragment, "uResolution", glm::vec2(t_target.width, t_target.height));
+        GPU::SetShaderUniform(t_pipeline.fragment, "uOffset", t_offset);
+
+        GPU::DrawArrays(3);
+        GPU::SetBlendingEnabled(true);
+        GPU::BindSampler(std::nullopt, 0);
+    }
+};
@@ -0,0 +1,164 @@
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
+
+// targets that were not acquired for this many frames are destroyed
+#define RENDER_TARGET_POOL_MAX_UNUSED_FRAMES 60
+
+namespace Raster {
+    std::vector<RenderTargetPoolEntry> RenderTargetPool::s_entries;
+    bool RenderTargetPool::s_aliasingAllowed = true;
+    bool RenderTargetPool::s_preserveRequested = false;
+    bool RenderTargetPool::s_uvAttachmentsRequired = false;
+    bool RenderTargetPool::s_uvAttachmentsRequested = false;
+
+    Framebuffer RenderTargetPool::Acquire() {
+        return Acquire(Compositor::GetRequiredResolution());
+    }
+
+    Framebuffer RenderTargetPool::Acquire(glm::vec2 t_resolution, TexturePrecision t_precision, int t_attachmentsCount) {
+        uint32_t width = std::max((uint32_t) t_resolution.x, (uint32_t) 1);
+        uint32_t height = std::max((uint32_t) t_resolution.y, (uint32_t) 1);
+        for (auto& entry : s_entries) {
+            auto& framebuffer = entry.framebuffer;
+            if (entry.acquired || entry.precision != t_precision) continue;
+            if (framebuffer.width != width || framebuffer.height != height || (int) framebuffer.attachments.size() != t_attachmentsCount) continue;
+            entry.acquired = true;
+            entry.unusedFrames = 0;
+            // ClearTarget() reads the previous owner's region before the new owner narrows it down again
+            entry.previousWrittenBounds = entry.writtenBounds;
+            entry.writtenBounds = std::nullopt;
+            return framebuffer;
+        }
+
+        GPUMemoryOwnerScope ownerScope(GPUMemoryOwner::Compositor);
+        std::vector<Texture> attachments;
+        for (int i = 0; i < t_attachmentsCount; i++) {
+            attachments.push_back(GPU::GenerateTexture(width, height, 4, t_precision));
+        }
+
+        RenderTargetPoolEntry entry;
+        entry.framebuffer = GPU::GenerateFramebuffer(width, height, attachments);
+        entry.precision = t_precision;
+        entry.acquired = true;
+        entry.unusedFrames = 0;
+        entry.writtenBounds = std::nullopt;
+        entry.previousWrittenBounds = std::nullopt;
+        s_entries.push_back(entry);
+        return entry.framebuffer;
+    }
+
+    void RenderTargetPool::Release(Framebuffer t_framebuffer) {
+        if (t_framebuffer.attachments.empty()) return;
+        auto entryCandidate = FindEntry(t_framebuffer.attachments[0].handle);
+        if (entryCandidate.has_value()) {
+            entryCandidate.value()->acquired = false;
+        }
+    }
+
+    void RenderTargetPool::Consume(Framebuffer t_framebuffer) {
+        if (!s_aliasingAllowed) return;
+        Release(t_framebuffer);
+    }
+
+    void RenderTargetPool::Consume(Texture t_texture) {
+        if (!s_aliasingAllowed) return;
+        auto entryCandidate = FindEntry(t_texture.handle);
+        if (entryCandidate.has_value()) {
+            entryCandidate.value()->acquired = false;
+        }
+    }
+
+    void RenderTargetPool::PreserveIntermediates() {
+        s_preserveRequested = true;
+    }
+
+    void RenderTargetPool::RequireUVAttachments() {
+        s_uvAttachmentsRequested = true;
+    }
+
+    int RenderTargetPool::GetCompatibleAttachmentsCount() {
+        return s_uvAttachmentsRequired ? 2 : 1;
+    }
+
+    void RenderTargetPool::ClearTarget(Framebuffer& t_framebuffer) {
+        std::optional<glm::ivec4> region = std::nullopt;
+        if (!t_framebuffer.attachments.empty()) {
+            auto entryCandidate = FindEntry(t_framebuffer.attachments[0].handle);
+            if (entryCandidate.has_value()) {
+                region = entryCandidate.value()->previousWrittenBounds;
+                entryCandidate.value()->previousWrittenBounds = ContentBounds::Empty();
+            }
+        }
+
+        if (ContentBounds::IsEmpty(region)) return;
+
+        GPU::BindFramebuffer(t_framebuffer);
+        GPU::SetScissor(region);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+        GPU::SetScissor(std::nullopt);
+    }
+
+    void RenderTargetPool::SetContentBounds(Framebuffer& t_framebuffer, std::optional<glm::ivec4> t_bounds, bool t_opaque) {
+        t_framebuffer.bounds = t_bounds;
+        t_framebuffer.opaque = t_opaque;
+        if (t_framebuffer.attachments.empty()) return;
+        auto entryCandidate = FindEntry(t_framebuffer.attachments[0].handle);
+        if (entryCandidate.has_value()) {
+            entryCandidate.value()->writtenBounds = t_bounds;
+        }
+    }
+
+    void RenderTargetPool::BeginFrame() {
+        s_aliasingAllowed = !s_preserveRequested;
+        s_preserveRequested = false;
+        s_uvAttachmentsRequired = s_uvAttachmentsRequested;
+        s_uvAttachmentsRequested = false;
+
+        std::vector<RenderTargetPoolEntry> survivors;
+        for (auto& entry : s_entries) {
+            if (entry.acquired) {
+                entry.acquired = false;
+                entry.unusedFrames = 0;
+            } else entry.unusedFrames++;
+
+            if (entry.unusedFrames > RENDER_TARGET_POOL_MAX_UNUSED_FRAMES) {
+                DestroyEntry(entry);
+            } else survivors.push_back(entry);
+        }
+        s_entries = survivors;
+    }
+
+    void RenderTargetPool::Clear() {
+        for (auto& entry : s_entries) {
+            DestroyEntry(entry);
+        }
+        s_entries.clear();
+    }
+
+    int RenderTargetPool::GetAllocatedCount() {
+        return (int) s_entries.size();
+    }
+
+    int RenderTargetPool::GetAcquiredCount() {
+        int count = 0;
+        for (auto& entry : s_entries) {
+            if (entry.acquired) count++;
+        }
+        return count;
+    }
+
+    std::optional<RenderTargetPoolEntry*> RenderTargetPool::FindEntry(void* t_colorHandle) {
+        if (!t_colorHandle) return std::nullopt;
+        for (auto& entry : s_entries) {
+            if (!entry.framebuffer.attachments.empty() && entry.framebuffer.attachments[0].handle == t_colorHandle) {
+                return &entry;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void RenderTargetPool::DestroyEntry(RenderTargetPoolEntry& t_entry) {
+        GPU::DestroyFramebufferWithAttachments(t_entry.framebuffer);
+        t_entry.framebuffer = Framebuffer();
+    }
+};
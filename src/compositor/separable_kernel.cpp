@@ -0,0 +1,71 @@
+#include "compositor/separable_kernel.h"
+
+namespace Raster {
+    SeparableKernelTaps SeparableKernel::Generate(KernelShape t_shape, float t_length, int t_maxTaps) {
+        float radius = glm::max(glm::abs(t_length) * 0.5f, 0.0f);
+        int maxTaps = glm::clamp(t_maxTaps, 1, SEPARABLE_KERNEL_MAX_TAPS);
+
+        // the center texel gets its own tap, every other tap merges two texels on one side
+        int texels = (int) glm::ceil(radius);
+        int maxPairs = (maxTaps - 1) / 2;
+        float stride = 1.0f;
+        if ((texels + 1) / 2 > maxPairs) {
+            stride = maxPairs > 0 ? radius / (float) (maxPairs * 2) : 1.0f;
+            texels = maxPairs * 2;
+        }
+
+        float sigma = glm::max(radius / 3.0f, 0.001f);
+        auto weight = [&](int t_texel) -> float {
+            if (t_texel > texels) return 0.0f;
+            if (t_shape == KernelShape::Box) return 1.0f;
+            float distance = t_texel * stride;
+            return glm::exp(-(distance * distance) / (2.0f * sigma * sigma));
+        };
+
+        std::vector<glm::vec2> taps = {glm::vec2(0.0f, weight(0))};
+        float total = taps[0].y;
+        for (int texel = 1; texel <= texels; texel += 2) {
+            float firstWeight = weight(texel);
+            float secondWeight = weight(texel + 1);
+            float pairWeight = firstWeight + secondWeight;
+            if (pairWeight <= 0.0f) continue;
+            // bilinear filtering between the two texels reproduces both of their weights
+            float offset = (texel * firstWeight + (texel + 1) * secondWeight) / pairWeight * stride;
+            taps.push_back(glm::vec2(offset, pairWeight));
+            taps.push_back(glm::vec2(-offset, pairWeight));
+            total += pairWeight * 2.0f;
+        }
+
+        SeparableKernelTaps result = {};
+        result.count = (int) taps.size();
+        for (int i = 0; i < result.count; i++) {
+            glm::vec2 tap = glm::vec2(taps[i].x, taps[i].y / total);
+            auto& packedTaps = result.taps[i / 2];
+            if (i % 2 == 0) {
+                packedTaps.x = tap.x;
+                packedTaps.y = tap.y;
+            } else {
+                packedTaps.z = tap.x;
+                packedTaps.w = tap.y;
+            }
+        }
+        return result;
+    }
+
+    void SeparableKernel::Apply(Pipeline& t_pipeline, Texture& t_source, Framebuffer& t_target, glm::vec2 t_direction, SeparableKernelTaps& t_taps, std::optional<glm::ivec4> t_region) {
+        GPU::BindFramebuffer(t_target);
+        GPU::BindPipeline(t_pipeline);
+        GPU::SetScissor(t_region);
+        // the pass overwrites its region, blending would apply the alpha once more per axis
+        GPU::SetBlendingEnabled(false);
+
+        GPU::BindTextureToShader(t_pipeline.fragment, "uTexture", t_source, 0);
+        GPU::SetShaderUniform(t_pipeline.fragment, "uDirection", t_direction);
+        GPU::SetShaderUniform(t_pipeline.fragment, "uResolution", glm::vec2(t_target.width, t_target.height));
+        GPU::BindUniformBlock(GPU::UploadUniformBlock(&t_taps, sizeof(t_taps)), 0);
+
+        GPU::DrawArrays(3);
+        GPU::SetBlendingEnabled(true);
+        GPU::SetScissor(std::nullopt);
+    }
+};
@@ -0,0 +1,32 @@
+#include "compositor/tile_compute.h"
+#include "compositor/content_bounds.h"
+
+namespace Raster {
+    glm::ivec2 TileCompute::GetApron(glm::vec2 t_extent) {
+        // one more texel for the bilinear footprint of the outermost sample
+        return glm::ivec2(glm::ceil(glm::abs(t_extent))) + 1;
+    }
+
+    bool TileCompute::IsApplicable(glm::vec2 t_extent, Texture& t_source, Framebuffer& t_target) {
+        if (t_target.attachments.empty() || t_target.attachments[0].precision != TexturePrecision::Usual) return false;
+        if (t_source.width != t_target.width || t_source.height != t_target.height) return false;
+        auto apron = GetApron(t_extent);
+        return apron.x <= TILE_COMPUTE_MAX_APRON && apron.y <= TILE_COMPUTE_MAX_APRON;
+    }
+
+    void TileCompute::Dispatch(Pipeline& t_pipeline, Framebuffer& t_target, std::optional<glm::ivec4> t_region, glm::ivec2 t_apron) {
+        glm::ivec4 region = t_region.value_or(glm::ivec4(0, 0, t_target.width, t_target.height));
+        if (ContentBounds::IsEmpty(region)) return;
+
+        GPU::BindImageTexture(t_target.attachments[0], 0, ImageAccess::Write);
+        GPU::SetShaderUniform(t_pipeline.compute, "uOrigin", glm::vec2(region.x, region.y));
+        GPU::SetShaderUniform(t_pipeline.compute, "uExtent", glm::vec2(region.z, region.w));
+        GPU::SetShaderUniform(t_pipeline.compute, "uApron", glm::vec2(t_apron));
+        GPU::SetShaderUniform(t_pipeline.compute, "uResolution", glm::vec2(t_target.width, t_target.height));
+
+        GPU::DispatchCompute(
+            (region.z + TILE_COMPUTE_GROUP_SIZE - 1) / TILE_COMPUTE_GROUP_SIZE,
+            (region.w + TILE_COMPUTE_GROUP_SIZE - 1) / TILE_COMPUTE_GROUP_SIZE
+        );
+    }
+};
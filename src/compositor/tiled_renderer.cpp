@@ -0,0 +1,151 @@
+#include "compositor/tiled_renderer.h"
+#include "compositor/render_target_pool.h"
+#include "traverser/traverser.h"
+#include "image/tiled_image_writer.h"
+#include "gpu/shader_compiler.h"
+
+// the sampling radius is measured on a full frame of at most this size
+#define TILED_RENDERER_PROBE_SIZE 1024
+// TIFF requires tile dimensions to be multiples of 16
+#define TILED_RENDERER_TILE_ALIGNMENT 64
+// assets that never finish loading (e.g. unreadable files) must not block the export forever
+#define TILED_RENDERER_MAX_WAIT_FRAMES 600
+
+namespace Raster {
+    std::vector<TiledRenderRequest> TiledRenderer::s_requests;
+    int TiledRenderer::s_waitedFrames = 0;
+
+    void TiledRenderer::Request(TiledRenderRequest t_request) {
+        s_requests.push_back(t_request);
+    }
+
+    void TiledRenderer::ProcessRequests() {
+        if (s_requests.empty() || !Workspace::s_project.has_value()) return;
+        auto request = s_requests.front();
+        bool waitExpired = s_waitedFrames >= TILED_RENDERER_MAX_WAIT_FRAMES;
+        // loading progresses between frames, the request stays queued until a prepare pass finds nothing pending
+        if (!Prepare(request) && !waitExpired) {
+            s_waitedFrames++;
+            return;
+        }
+        if (waitExpired) {
+            print("shaders or assets are still loading after " << s_waitedFrames << " frames, rendering '" << request.path << "' anyway");
+        }
+
+        auto renderBeginTime = std::chrono::steady_clock::now();
+        bool interrupted = false;
+        bool succeeded = Render(request, interrupted);
+        if (interrupted && !waitExpired) {
+            std::error_code errorCode;
+            std::filesystem::remove(request.path, errorCode);
+            s_waitedFrames++;
+            return;
+        }
+        auto renderTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - renderBeginTime).count();
+        print((succeeded ? "rendered " : "failed to render ") << request.resolution.x << "x" << request.resolution.y << " frame to '" << request.path << "' in " << renderTime << "s");
+
+        s_requests.erase(s_requests.begin());
+        s_waitedFrames = 0;
+    }
+
+    bool TiledRenderer::Prepare(TiledRenderRequest& t_request) {
+        if (t_request.resolution.x <= 0 || t_request.resolution.y <= 0) return true;
+        glm::ivec2 regionSize = glm::min(t_request.resolution, glm::ivec2(TILED_RENDERER_TILE_ALIGNMENT));
+        RenderRegion(glm::ivec4(0, 0, regionSize), t_request.resolution, std::nullopt);
+        return !IsPending();
+    }
+
+    bool TiledRenderer::IsPending() {
+        if (ShaderCompiler::GetPendingCount() > 0) return true;
+        for (auto& asset : Workspace::s_project.value().assets) {
+            if (asset->IsLoading()) return true;
+        }
+        return false;
+    }
+
+    bool TiledRenderer::Render(TiledRenderRequest& t_request, bool& t_interrupted) {
+        auto& resolution = t_request.resolution;
+        if (resolution.x <= 0 || resolution.y <= 0) return false;
+        int maxTextureSize = GPU::info.maxTextureSize > 0 ? GPU::info.maxTextureSize : 4096;
+
+        glm::vec2 radius = MeasureSamplingRadius(resolution, maxTextureSize);
+        int guardBand = (int) std::ceil(std::max(radius.x, radius.y)) + 2;
+        int tileSize = std::min(t_request.tileSize, maxTextureSize - guardBand * 2);
+        tileSize = tileSize / TILED_RENDERER_TILE_ALIGNMENT * TILED_RENDERER_TILE_ALIGNMENT;
+        if (tileSize < TILED_RENDERER_TILE_ALIGNMENT) {
+            tileSize = TILED_RENDERER_TILE_ALIGNMENT;
+            guardBand = (maxTextureSize - tileSize) / 2;
+            print("guard band of the tiled render is clamped to " << guardBand << "px, wide blurs may show seams");
+        }
+
+        TiledImageWriter writer;
+        if (!writer.Open(t_request.path, resolution.x, resolution.y, tileSize)) return false;
+
+        // layers of high precision outputs are blended in half floats and read back unclamped
+        bool highPrecision = TiledImageWriter::IsHighPrecisionFormat(t_request.path);
+        TexturePrecision precision = highPrecision ? TexturePrecision::Half : TexturePrecision::Usual;
+        size_t pixelSize = highPrecision ? 4 * sizeof(float) : 4;
+
+        int framebufferSize = tileSize + guardBand * 2;
+        auto framebuffer = Compositor::GenerateCompatibleFramebuffer({framebufferSize, framebufferSize}, precision);
+
+        bool succeeded = true;
+        Image tile;
+        tile.channels = 4;
+        tile.precision = highPrecision ? ImagePrecision::Full : ImagePrecision::Usual;
+        for (int y = 0; y < resolution.y && succeeded; y += tileSize) {
+            for (int x = 0; x < resolution.x && succeeded; x += tileSize) {
+                RenderRegion(glm::ivec4(x - guardBand, y - guardBand, framebufferSize, framebufferSize), resolution, framebuffer);
+
+                tile.width = std::min(tileSize, resolution.x - x);
+                tile.height = std::min(tileSize, resolution.y - y);
+                tile.data.resize((size_t) tile.width * tile.height * pixelSize);
+                GPU::ReadPixels(framebuffer, 0, glm::ivec4(guardBand, guardBand, tile.width, tile.height), tile.data.data(), precision);
+                succeeded = writer.WriteTile(x, y, tile);
+
+                // once the wait expired the frame is finished with whatever is loaded
+                if (succeeded && s_waitedFrames < TILED_RENDERER_MAX_WAIT_FRAMES && IsPending()) {
+                    t_interrupted = true;
+                    succeeded = false;
+                }
+            }
+        }
+
+        GPU::DestroyFramebufferWithAttachments(framebuffer);
+        return writer.Close() && succeeded;
+    }
+
+    glm::vec2 TiledRenderer::MeasureSamplingRadius(glm::ivec2 t_resolution, int t_maxTextureSize) {
+        // radii are proportional to the output resolution, so a downscaled frame is enough to find them
+        float scale = std::min(1.0f, (float) std::min(TILED_RENDERER_PROBE_SIZE, t_maxTextureSize) / (float) std::max(t_resolution.x, t_resolution.y));
+        glm::ivec2 probeResolution = glm::max(glm::ivec2(glm::vec2(t_resolution) * scale), glm::ivec2(1));
+
+        Compositor::s_samplingRadius = glm::vec2(0);
+        RenderRegion(glm::ivec4(0, 0, probeResolution), probeResolution, std::nullopt);
+        return Compositor::s_samplingRadius / scale;
+    }
+
+    void TiledRenderer::RenderRegion(glm::ivec4 t_region, glm::ivec2 t_resolution, std::optional<Framebuffer> t_framebuffer) {
+        auto& project = Workspace::s_project.value();
+        project.renderRegion = glm::vec4(t_region) / glm::vec4(t_resolution, t_resolution);
+        Compositor::s_renderTile = RenderTile{
+            .region = t_region,
+            .outputResolution = t_resolution
+        };
+
+        Compositor::s_bundles.clear();
+        Compositor::s_targets.clear();
+        RenderTargetPool::BeginFrame();
+        {
+            GPUMemoryOwnerScope ownerScope(GPUMemoryOwner::Node);
+            Traverser::TraverseAll();
+        }
+        if (t_framebuffer.has_value()) {
+            Compositor::PerformManualComposition(Compositor::s_targets, t_framebuffer.value());
+        }
+
+        Compositor::s_targets.clear();
+        Compositor::s_renderTile = std::nullopt;
+        project.renderRegion = std::nullopt;
+    }
+};
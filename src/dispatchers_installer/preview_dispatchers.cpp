@@ -439,9 +439,10 @@ namespace Raster {
         auto framebuffer = std::any_cast<Framebuffer>(t_attribute);
         if (framebuffer.attachments.empty()) return;
 
-        static int attachmentIndex = 0;
-        if (attachmentIndex >= framebuffer.attachments.size()) attachmentIndex = framebuffer.attachments.size() - 1;
-        std::any textureTarget = framebuffer.attachments[attachmentIndex];
+        // UV attachments only exist while they are previewed, the choice is kept until the next frame provides them
+        int& attachmentIndex = Dispatchers::s_previewAttachment;
+        int shownAttachment = std::min(attachmentIndex, (int) framebuffer.attachments.size() - 1);
+        std::any textureTarget = framebuffer.attachments[shownAttachment];
 
         DispatchTextureValue(textureTarget);
 
@@ -452,7 +453,7 @@ namespace Raster {
         });
         ImGui::BeginChild("##attachmentContainer", ImVec2(attachmentChooserSizeX, 30));
         float firstCursorX = ImGui::GetCursorPosX();
-        for (int i = 0; i < framebuffer.attachments.size(); i++) {
+        for (int i = 0; i < std::max((int) framebuffer.attachments.size(), 2); i++) {
             auto buttonColor = ImGui::GetStyleColorVec4(ImGuiCol_Button);
             buttonColor = attachmentIndex == i ? buttonColor * 1.1f : buttonColor * 0.8f;
             buttonColor.w = 1.0f;
@@ -10,6 +10,7 @@ namespace Raster {
     AsyncUploadInfo::AsyncUploadInfo() {
         this->ready = false;
         this->executed = false;
+        this->owner = GPUMemoryOwner::Other;
     }
 
     void AsyncUpload::Initialize() {
@@ -30,16 +31,29 @@ namespace Raster {
         info.image = image;
         info.ready = false;
         info.texture = Texture();
+        info.owner = GPU::GetMemoryOwner();
 
         SyncPutAsyncUploadInfo(uploadID, info);
 
         return uploadID;
     }
 
-    void AsyncUpload::DestroyTexture(Texture texture) {
+    AsyncUploadInfoID AsyncUpload::GenerateTextureFromCompressedImage(std::shared_ptr<CompressedImage> t_image) {
+        int uploadID = Randomizer::GetRandomInteger();
         AsyncUploadInfo info;
-        info.deleteTexture = texture;
-        SyncPutAsyncUploadInfo(Randomizer::GetRandomInteger(), info);
+        info.compressedImage = t_image;
+        info.ready = false;
+        info.texture = Texture();
+        info.owner = GPU::GetMemoryOwner();
+
+        SyncPutAsyncUploadInfo(uploadID, info);
+
+        return uploadID;
+    }
+
+    void AsyncUpload::DestroyTexture(Texture texture) {
+        // destruction is deferred to the main context, no round trip through the uploader is needed
+        GPU::DestroyTexture(texture);
     }
 
     bool AsyncUpload::IsUploadReady(AsyncUploadInfoID t_id) {
@@ -73,22 +87,25 @@ namespace Raster {
             if (info.executed) continue;
 
             info.executed = true;
-            if (info.deleteTexture.handle) {
-                GPU::DestroyTexture(info.deleteTexture);
-                SyncDestroyAsyncUploadInfo(pair.first);
-                continue;
-            }
-
-            TexturePrecision precision = TexturePrecision::Usual;
-            if (info.image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
-            if (info.image->precision == ImagePrecision::Full) precision = TexturePrecision::Full;
 
-            auto generatedTexture = GPU::GenerateTexture(info.image->width, info.image->height, info.image->channels, precision);
-            GPU::UpdateTexture(generatedTexture, 0, 0, info.image->width, info.image->height, info.image->channels, info.image->data.data());
+            GPUMemoryOwnerScope ownerScope(info.owner);
+            Texture generatedTexture;
+            if (info.compressedImage) {
+                auto& compressed = *info.compressedImage;
+                generatedTexture = GPU::GenerateCompressedTexture(compressed.width, compressed.height, compressed.channels, compressed.data.data(), compressed.data.size());
+            } else {
+                TexturePrecision precision = TexturePrecision::Usual;
+                if (info.image->precision == ImagePrecision::Half) precision = TexturePrecision::Half;
+                if (info.image->precision == ImagePrecision::Full) precision = TexturePrecision::Full;
+
+                generatedTexture = GPU::GenerateTexture(info.image->width, info.image->height, info.image->channels, precision);
+                GPU::UpdateTexture(generatedTexture, 0, 0, info.image->width, info.image->height, info.image->channels, info.image->GetData());
+            }
             GPU::Flush();
 
             info.texture = generatedTexture;
             info.image = nullptr;
+            info.compressedImage = nullptr;
             info.ready = true;
 
             SyncPutAsyncUploadInfo(pair.first, info);
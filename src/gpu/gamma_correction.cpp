@@ -0,0 +1,51 @@
+#include "gpu/gamma_correction.h"
+
+namespace Raster {
+    PendingPipeline GammaCorrection::s_pipeline;
+
+    bool GammaCorrection::IsReady() {
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::RequestShader(ShaderType::Vertex, "gamma_correction/shader"),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "gamma_correction/shader")
+            );
+        }
+        return s_pipeline.Get().has_value();
+    }
+
+    bool GammaCorrection::IsRequired(std::string t_path) {
+        return LowerCase(std::filesystem::path(t_path).extension().string()) == ".exr";
+    }
+
+    void GammaCorrection::Apply(Texture& t_texture, float t_gamma) {
+        auto pipelineCandidate = s_pipeline.Get();
+        if (!pipelineCandidate.has_value()) return;
+        auto& pipeline = pipelineCandidate.value();
+
+        Texture copiedTexture = GPU::GenerateTexture(t_texture.width, t_texture.height, t_texture.channels, t_texture.precision);
+        Texture gammaTexture = GPU::GenerateTexture(t_texture.width, t_texture.height, t_texture.channels, t_texture.precision);
+
+        Framebuffer gammaFbo = GPU::GenerateFramebuffer(t_texture.width, t_texture.height, {gammaTexture});
+
+        GPU::BlitTexture(copiedTexture, t_texture);
+
+        GPU::BindFramebuffer(gammaFbo);
+        GPU::BindPipeline(pipeline);
+        GPU::ClearFramebuffer(0, 0, 0, 0);
+
+        GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(t_texture.width, t_texture.height));
+        GPU::SetShaderUniform(pipeline.fragment, "uGamma", t_gamma);
+        GPU::BindTextureToShader(pipeline.fragment, "uColor", copiedTexture, 0);
+        GPU::SetShaderUniform(pipeline.fragment, "uUVAvailable", 0);
+
+        GPU::DrawArrays(3);
+
+        GPU::BindFramebuffer(std::nullopt);
+
+        GPU::BlitTexture(t_texture, gammaTexture);
+
+        GPU::DestroyTexture(copiedTexture);
+        GPU::DestroyTexture(gammaTexture);
+        GPU::DestroyFramebuffer(gammaFbo);
+    }
+};
\ No newline at end of file
@@ -15,10 +15,28 @@
 #include "image/image.h"
 
 #include <nfd_glfw3.h>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
 
 #define HANDLE_TO_GLUINT(x) ((uint32_t) (uint64_t) (x))
 #define GLUINT_TO_HANDLE(x) ((void*) (uint64_t) (x))
 
+// EXT_disjoint_timer_query is not part of the generated loader
+#ifndef GL_TIME_ELAPSED_EXT
+    #define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+    #define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+#define TIMER_QUERIES_COUNT 4
+// texture units covered by the state shadow, binds to higher units always reach the driver
+#define SHADOWED_TEXTURE_UNITS 16
+#define UNKNOWN_GL_STATE 0xFFFFFFFFu
+// uniform blocks of a few frames fit into the ring before it wraps around
+#define UNIFORM_RING_SIZE (1024 * 1024)
+
 namespace Raster {
 
     GPUInfo GPU::info{};
@@ -110,28 +128,59 @@ namespace Raster {
         return GL_RGB;
     }
 
-    static unsigned int RSHash(const std::string& str)
-    {
-        unsigned int b    = 378551;
-        unsigned int a    = 63689;
-        unsigned int hash = 0;
+    typedef void (*PFNGLGETQUERYOBJECTUI64VEXTPROC)(GLuint id, GLenum pname, GLuint64* params);
+
+    static PFNGLGETQUERYOBJECTUI64VEXTPROC s_glGetQueryObjectui64vEXT = nullptr;
+    static GLuint s_timerQueries[TIMER_QUERIES_COUNT];
+    static bool s_timerQueryPending[TIMER_QUERIES_COUNT] = {};
+    static int s_timerQueryIndex = 0;
+    static bool s_timerQueryActive = false;
+    static std::optional<float> s_lastTimerQueryResult;
+
+    static uint64_t MixShaderHash(uint64_t t_value) {
+        t_value ^= t_value >> 33;
+        t_value *= 0xff51afd7ed558ccdULL;
+        t_value ^= t_value >> 33;
+        t_value *= 0xc4ceb9fe1a85ec53ULL;
+        t_value ^= t_value >> 33;
+        return t_value;
+    }
 
-        for(std::size_t i = 0; i < str.length(); i++)
-        {
-            hash = hash * a + str[i];
-            a    = a * b;
+    // 128-bit content hash (two independent 64-bit lanes), collisions between generated shaders must never load a wrong binary
+    static std::string HashShaderSource(const std::string& t_source) {
+        uint64_t a = 0x9E3779B97F4A7C15ULL;
+        uint64_t b = 0xC2B2AE3D27D4EB4FULL;
+        size_t wordsCount = t_source.size() / 8;
+        for (size_t i = 0; i < wordsCount; i++) {
+            uint64_t word;
+            std::memcpy(&word, t_source.data() + i * 8, 8);
+            a = (a ^ word) * 0xff51afd7ed558ccdULL;
+            a ^= a >> 32;
+            b = (b + word) * 0xc4ceb9fe1a85ec53ULL;
+            b ^= b >> 29;
         }
-
-        return (hash & 0x7FFFFFFF);
+        for (size_t i = wordsCount * 8; i < t_source.size(); i++) {
+            a = (a ^ (uint8_t) t_source[i]) * 0xff51afd7ed558ccdULL;
+            b = (b + (uint8_t) t_source[i]) * 0xc4ceb9fe1a85ec53ULL;
+        }
+        return FormatString("%016llx%016llx",
+            (unsigned long long) MixShaderHash(a ^ t_source.size()),
+            (unsigned long long) MixShaderHash(b + t_source.size()));
     }
 
 
     Texture::Texture() {
+        this->compressed = false;
         this->handle = nullptr;
+        this->generation = 0;
     }
 
     Framebuffer::Framebuffer() {
         this->handle = nullptr;
+        this->depthHandle = nullptr;
+        this->generation = 0;
+        this->bounds = std::nullopt;
+        this->opaque = false;
     }
 
     Sampler::Sampler(uint64_t handle) {
@@ -151,11 +200,153 @@ namespace Raster {
         this->handle = handle;
     }
 
+    UniformHandle::UniformHandle() {
+        this->shader = nullptr;
+        this->location = -1;
+    }
+
     static std::thread::id s_mainThreadID;
     static std::unordered_map<void*, std::unordered_map<std::string, int>> shaderRegistry;
+    // GPU::GetSampler() samplers keyed by wrapping mode * 2 + filtering mode
+    static std::unordered_map<int, Sampler> s_samplerCache;
+
+    // Shadow copy of the main context's state, binds that wouldn't change anything never reach the driver.
+    // Worker contexts aren't shadowed, ImGui rendering at the end of the frame invalidates everything
+    struct GLStateShadow {
+        GLuint framebuffer;
+        glm::ivec4 viewport;
+        GLuint pipeline;
+        GLuint activeTextureUnit;
+        GLuint textures[SHADOWED_TEXTURE_UNITS];
+        GLuint samplers[SHADOWED_TEXTURE_UNITS];
+        GLuint blending;
+        GLuint scissorTest;
+        glm::ivec4 scissor;
+    };
+
+    static GLStateShadow s_state;
+    static GPUFrameStatistics s_statistics{}, s_lastStatistics{};
+
+    // objects are generated and destroyed by the uploader and shader compiler threads too
+    static std::atomic<int> s_liveTextures = 0, s_liveFramebuffers = 0, s_liveSamplers = 0, s_liveShaders = 0, s_livePipelines = 0;
+
+    // framebuffer objects aren't shared between contexts, the pair is deleted together on the main one
+    struct PendingFramebufferDestruction {
+        GLuint framebuffer, depthRenderbuffer;
+    };
+
+    // owner and size of every live texture and framebuffer depth buffer, guarded by s_destructionMutex.
+    // Only names found here with a matching generation are destroyed, so copies that outlive their object can't delete a reused name
+    struct MemoryAllocation {
+        GPUMemoryOwner owner;
+        uint64_t bytes;
+        uint32_t generation;
+    };
+
+    static thread_local GPUMemoryOwner s_memoryOwner = GPUMemoryOwner::Other;
+    static std::unordered_map<GLuint, MemoryAllocation> s_textureAllocations, s_depthAllocations;
+    static uint64_t s_allocatedBytes[GPU_MEMORY_OWNERS_COUNT] = {};
+    static uint32_t s_allocationGeneration = 0;
+
+    static uint32_t TrackAllocation(std::unordered_map<GLuint, MemoryAllocation>& t_allocations, GLuint t_handle, uint64_t t_bytes);
+    static bool IsAllocationLive(std::unordered_map<GLuint, MemoryAllocation>& t_allocations, GLuint t_handle, uint32_t t_generation);
+    static void UntrackAllocation(std::unordered_map<GLuint, MemoryAllocation>& t_allocations, GLuint t_handle);
+
+    static std::mutex s_destructionMutex;
+    static std::unordered_set<GLuint> s_pendingTextureDestructions;
+    static std::vector<PendingFramebufferDestruction> s_pendingFramebufferDestructions;
+    static std::unordered_set<GLuint> s_queuedFramebuffers;
+
+    static void InvalidateStateShadow() {
+        s_state.framebuffer = UNKNOWN_GL_STATE;
+        s_state.viewport = glm::ivec4(-1);
+        s_state.pipeline = UNKNOWN_GL_STATE;
+        s_state.activeTextureUnit = UNKNOWN_GL_STATE;
+        for (int i = 0; i < SHADOWED_TEXTURE_UNITS; i++) {
+            s_state.textures[i] = UNKNOWN_GL_STATE;
+            s_state.samplers[i] = UNKNOWN_GL_STATE;
+        }
+        s_state.blending = UNKNOWN_GL_STATE;
+        s_state.scissorTest = UNKNOWN_GL_STATE;
+        s_state.scissor = glm::ivec4(-1);
+    }
+
+    static bool IsStateShadowed() {
+        return std::this_thread::get_id() == s_mainThreadID;
+    }
+
+    static void SetActiveTextureUnit(GLuint t_unit) {
+        if (IsStateShadowed() && s_state.activeTextureUnit == t_unit) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        glActiveTexture(GL_TEXTURE0 + t_unit);
+        if (IsStateShadowed()) {
+            s_state.activeTextureUnit = t_unit;
+            s_statistics.stateChanges++;
+        }
+    }
+
+    // binds to the active texture unit
+    static void BindTexture2D(GLuint t_texture) {
+        if (!IsStateShadowed()) {
+            glBindTexture(GL_TEXTURE_2D, t_texture);
+            return;
+        }
+        GLuint unit = s_state.activeTextureUnit;
+        if (unit < SHADOWED_TEXTURE_UNITS && s_state.textures[unit] == t_texture) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        glBindTexture(GL_TEXTURE_2D, t_texture);
+        s_statistics.textureBinds++;
+        if (unit < SHADOWED_TEXTURE_UNITS) s_state.textures[unit] = t_texture;
+    }
+
+    static void BindFramebufferHandle(GLuint t_framebuffer) {
+        if (IsStateShadowed() && s_state.framebuffer == t_framebuffer) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, t_framebuffer);
+        if (IsStateShadowed()) {
+            s_state.framebuffer = t_framebuffer;
+            s_statistics.framebufferBinds++;
+        }
+    }
+
+    static void SetViewport(glm::ivec4 t_viewport) {
+        if (IsStateShadowed() && s_state.viewport == t_viewport) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        glViewport(t_viewport.x, t_viewport.y, t_viewport.z, t_viewport.w);
+        if (IsStateShadowed()) {
+            s_state.viewport = t_viewport;
+            s_statistics.stateChanges++;
+        }
+    }
+
+    static void SetCapability(GLenum t_capability, GLuint& t_shadow, bool t_enabled) {
+        if (IsStateShadowed() && t_shadow == (GLuint) t_enabled) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        if (t_enabled) glEnable(t_capability);
+        else glDisable(t_capability);
+        if (IsStateShadowed()) {
+            t_shadow = (GLuint) t_enabled;
+            s_statistics.stateChanges++;
+        }
+    }
+
+    static GLuint s_uniformRing = 0;
+    static uint32_t s_uniformRingOffset = 0;
+    static uint32_t s_uniformRingAlignment = 256;
 
     void GPU::Initialize() {
         s_mainThreadID = std::this_thread::get_id();
+        InvalidateStateShadow();
         if (!glfwInit()) {
             throw std::runtime_error("cannot initialize glfw!");
         }
@@ -201,11 +392,66 @@ namespace Raster {
 
         info.version = std::string((const char*) glGetString(GL_VERSION));
         info.renderer = std::string((const char*) glGetString(GL_RENDERER)) + std::string(" / GLFW ") + glfwGetVersionString();
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &info.maxTextureSize);
+
+        GLint uniformBufferAlignment;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferAlignment);
+        s_uniformRingAlignment = std::max(uniformBufferAlignment, 1);
+        glGenBuffers(1, &s_uniformRing);
+        glBindBuffer(GL_UNIFORM_BUFFER, s_uniformRing);
+        glBufferData(GL_UNIFORM_BUFFER, UNIFORM_RING_SIZE, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
         std::cout << info.version << std::endl;
         std::cout << info.renderer << std::endl;
 
         s_basicShader = GPU::GenerateShader(ShaderType::Vertex, "basic/shader");
+
+        if (glfwExtensionSupported("GL_EXT_disjoint_timer_query")) {
+            s_glGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC) glfwGetProcAddress("glGetQueryObjectui64vEXT");
+            if (s_glGetQueryObjectui64vEXT) {
+                glGenQueries(TIMER_QUERIES_COUNT, s_timerQueries);
+            }
+        }
+    }
+
+    bool GPU::IsTimerQuerySupported() {
+        return s_glGetQueryObjectui64vEXT != nullptr;
+    }
+
+    void GPU::BeginTimerQuery() {
+        if (!IsTimerQuerySupported() || s_timerQueryActive) return;
+        // the slot is still in flight, skip this measurement instead of waiting for it
+        if (s_timerQueryPending[s_timerQueryIndex]) return;
+        glBeginQuery(GL_TIME_ELAPSED_EXT, s_timerQueries[s_timerQueryIndex]);
+        s_timerQueryActive = true;
+    }
+
+    void GPU::EndTimerQuery() {
+        if (!s_timerQueryActive) return;
+        glEndQuery(GL_TIME_ELAPSED_EXT);
+        s_timerQueryActive = false;
+        s_timerQueryPending[s_timerQueryIndex] = true;
+        s_timerQueryIndex = (s_timerQueryIndex + 1) % TIMER_QUERIES_COUNT;
+    }
+
+    std::optional<float> GPU::GetLastTimerQueryResult() {
+        if (!IsTimerQuerySupported()) return std::nullopt;
+        // a disjoint event (frequency change, context loss) invalidates every query in flight
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        for (int i = 0; i < TIMER_QUERIES_COUNT; i++) {
+            int index = (s_timerQueryIndex + i) % TIMER_QUERIES_COUNT;
+            if (!s_timerQueryPending[index]) continue;
+            GLuint available = 0;
+            glGetQueryObjectuiv(s_timerQueries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) break;
+            GLuint64 elapsed = 0;
+            s_glGetQueryObjectui64vEXT(s_timerQueries[index], GL_QUERY_RESULT, &elapsed);
+            s_timerQueryPending[index] = false;
+            if (!disjoint) s_lastTimerQueryResult = (float) ((double) elapsed / 1000000.0);
+        }
+        return s_lastTimerQueryResult;
     }
 
     void GPU::Flush() {
@@ -236,10 +482,82 @@ namespace Raster {
         return glfwWindowShouldClose((GLFWwindow*) info.display);
     }
 
+    static uint32_t TrackAllocation(std::unordered_map<GLuint, MemoryAllocation>& t_allocations, GLuint t_handle, uint64_t t_bytes) {
+        std::lock_guard<std::mutex> guard(s_destructionMutex);
+        t_allocations[t_handle] = MemoryAllocation{
+            .owner = s_memoryOwner,
+            .bytes = t_bytes,
+            .generation = ++s_allocationGeneration
+        };
+        s_allocatedBytes[static_cast<int>(s_memoryOwner)] += t_bytes;
+        return s_allocationGeneration;
+    }
+
+    // must be called with s_destructionMutex locked
+    static bool IsAllocationLive(std::unordered_map<GLuint, MemoryAllocation>& t_allocations, GLuint t_handle, uint32_t t_generation) {
+        auto allocation = t_allocations.find(t_handle);
+        return allocation != t_allocations.end() && allocation->second.generation == t_generation;
+    }
+
+    static void UntrackAllocation(std::unordered_map<GLuint, MemoryAllocation>& t_allocations, GLuint t_handle) {
+        std::lock_guard<std::mutex> guard(s_destructionMutex);
+        auto allocation = t_allocations.find(t_handle);
+        if (allocation == t_allocations.end()) return;
+        s_allocatedBytes[static_cast<int>(allocation->second.owner)] -= allocation->second.bytes;
+        t_allocations.erase(allocation);
+    }
+
+    GPUMemoryOwnerScope::GPUMemoryOwnerScope(GPUMemoryOwner t_owner) {
+        this->m_previousOwner = s_memoryOwner;
+        s_memoryOwner = t_owner;
+    }
+
+    GPUMemoryOwnerScope::~GPUMemoryOwnerScope() {
+        s_memoryOwner = m_previousOwner;
+    }
+
+    // runs on the main context, whatever the previous frame drew or ImGui displayed from these objects is already submitted
+    static void ExecutePendingDestructions() {
+        std::unordered_set<GLuint> textures;
+        std::vector<PendingFramebufferDestruction> framebuffers;
+        {
+            std::lock_guard<std::mutex> guard(s_destructionMutex);
+            textures.swap(s_pendingTextureDestructions);
+            framebuffers.swap(s_pendingFramebufferDestructions);
+            s_queuedFramebuffers.clear();
+        }
+
+        for (auto& framebuffer : framebuffers) {
+            UntrackAllocation(s_depthAllocations, framebuffer.depthRenderbuffer);
+            glDeleteRenderbuffers(1, &framebuffer.depthRenderbuffer);
+            glDeleteFramebuffers(1, &framebuffer.framebuffer);
+            // deleting the bound framebuffer reverts the binding to the default one
+            if (s_state.framebuffer == framebuffer.framebuffer) s_state.framebuffer = 0;
+        }
+        s_liveFramebuffers -= (int) framebuffers.size();
+
+        for (auto textureHandle : textures) {
+            UntrackAllocation(s_textureAllocations, textureHandle);
+            glDeleteTextures(1, &textureHandle);
+            // deleted textures are unbound from every unit, the name may be reused right away
+            for (auto& boundTexture : s_state.textures) {
+                if (boundTexture == textureHandle) boundTexture = 0;
+            }
+        }
+        s_liveTextures -= (int) textures.size();
+    }
+
     void GPU::BeginFrame() {
         glfwPollEvents();
 
+        // ImGui rendered with its own state since the last frame
+        InvalidateStateShadow();
+        ExecutePendingDestructions();
+        s_lastStatistics = s_statistics;
+        s_statistics = GPUFrameStatistics{};
+
         GPU::BindFramebuffer(std::nullopt);
+        GPU::SetScissor(std::nullopt);
         glClear(GL_COLOR_BUFFER_BIT);
 
         ImGui_ImplOpenGL3_NewFrame();
@@ -265,7 +583,7 @@ namespace Raster {
     Texture GPU::GenerateTexture(uint32_t width, uint32_t height, int channels, TexturePrecision precision) {
         GLuint textureHandle;
         glGenTextures(1, &textureHandle);
-        glBindTexture(GL_TEXTURE_2D, textureHandle);
+        BindTexture2D(textureHandle);
         
         auto format = InterpretTextureInfo(channels, precision);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -281,11 +599,38 @@ namespace Raster {
         texture.precision = precision;
         texture.channels = channels;
         texture.handle = GLUINT_TO_HANDLE(textureHandle);
+        s_liveTextures++;
+        texture.generation = TrackAllocation(s_textureAllocations, textureHandle, GetTextureMemory(texture));
+        return texture;
+    }
+
+    Texture GPU::GenerateCompressedTexture(uint32_t width, uint32_t height, int channels, const void* data, size_t size) {
+        GLuint textureHandle;
+        glGenTextures(1, &textureHandle);
+        BindTexture2D(textureHandle);
+
+        auto format = channels == 4 ? GL_COMPRESSED_RGBA8_ETC2_EAC : GL_COMPRESSED_RGB8_ETC2;
+        glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, (GLsizei) size, data);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        Texture texture;
+        texture.width = width;
+        texture.height = height;
+        texture.precision = TexturePrecision::Usual;
+        texture.channels = channels;
+        texture.compressed = true;
+        texture.handle = GLUINT_TO_HANDLE(textureHandle);
+        s_liveTextures++;
+        texture.generation = TrackAllocation(s_textureAllocations, textureHandle, GetTextureMemory(texture));
         return texture;
     }
 
     void GPU::UpdateTexture(Texture texture, uint32_t x, uint32_t y, uint32_t w, uint32_t h, int channels, void* pixels) {
-        glBindTexture(GL_TEXTURE_2D, HANDLE_TO_GLUINT(texture.handle));
+        BindTexture2D(HANDLE_TO_GLUINT(texture.handle));
 
         auto format = GL_UNSIGNED_BYTE;
         if (texture.precision == TexturePrecision::Full) format = GL_FLOAT;
@@ -317,29 +662,39 @@ namespace Raster {
     }
 
     void GPU::DestroyTexture(Texture texture) {
-        GLuint textureHandle = (uint32_t) (uint64_t) texture.handle;
-        glDeleteTextures(1, &textureHandle);
+        if (!texture.handle) return;
+        GLuint textureHandle = HANDLE_TO_GLUINT(texture.handle);
+        std::lock_guard<std::mutex> guard(s_destructionMutex);
+        // already deleted in an earlier frame, the name may belong to another texture by now
+        if (!IsAllocationLive(s_textureAllocations, textureHandle, texture.generation)) return;
+        s_pendingTextureDestructions.insert(textureHandle);
     }
 
-    void GPU::BindTextureToShader(Shader shader, std::string name, Texture texture, int unit) {
-        glActiveTexture(GL_TEXTURE0 + unit);
-        glBindTexture(GL_TEXTURE_2D, HANDLE_TO_GLUINT(texture.handle));
+    void GPU::BindTextureToShader(Shader shader, const std::string& name, Texture texture, int unit) {
+        SetActiveTextureUnit(unit);
+        BindTexture2D(HANDLE_TO_GLUINT(texture.handle));
         SetShaderUniform(shader, name, unit);
     }
 
+    void GPU::BindTextureToShader(UniformHandle handle, Texture texture, int unit) {
+        SetActiveTextureUnit(unit);
+        BindTexture2D(HANDLE_TO_GLUINT(texture.handle));
+        SetShaderUniform(handle, unit);
+    }
+
     // TODO: return std::optional<Framebuffer> instead of Framebuffer
     Framebuffer GPU::GenerateFramebuffer(uint32_t width, uint32_t height, std::vector<Texture> attachments) {
         Framebuffer fbo;
         GLuint fboHandle;
         glGenFramebuffers(1, &fboHandle);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, fboHandle);
+        BindFramebufferHandle(fboHandle);
 
         int attachmentIndex = 0;
         std::vector<GLuint> attachmentBuffers;
         for (auto& attachment : attachments) {
             GLuint textureHandle = (GLuint) (uint64_t) attachment.handle;
-            glBindTexture(GL_TEXTURE_2D, textureHandle);
+            BindTexture2D(textureHandle);
             attachmentBuffers.push_back(GL_COLOR_ATTACHMENT0 + attachmentIndex);
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + attachmentIndex++, GL_TEXTURE_2D, textureHandle, 0);
         }
@@ -355,6 +710,9 @@ namespace Raster {
 
         fbo.handle = GLUINT_TO_HANDLE(fboHandle);
         fbo.depthHandle = GLUINT_TO_HANDLE(depthHandle);
+        s_liveFramebuffers++;
+        // GL_DEPTH24_STENCIL8
+        fbo.generation = TrackAllocation(s_depthAllocations, depthHandle, (uint64_t) width * height * 4);
         fbo.attachments = attachments;
         fbo.width = width;
         fbo.height = height;
@@ -366,7 +724,7 @@ namespace Raster {
         glClearColor(0, 0, 0, 1);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        BindFramebufferHandle(0);
 
         return fbo;
     }
@@ -380,90 +738,91 @@ namespace Raster {
     }
 
     void GPU::DestroyFramebuffer(Framebuffer fbo) {
-        GLuint fboHandle = (uint32_t) (uint64_t) fbo.handle;
-        GLuint depthHandle = (uint32_t) (uint64_t) fbo.depthHandle;
-        glDeleteRenderbuffers(1, &depthHandle);
-        glDeleteFramebuffers(1, &fboHandle);
+        if (!fbo.handle) return;
+        GLuint fboHandle = HANDLE_TO_GLUINT(fbo.handle);
+        std::lock_guard<std::mutex> guard(s_destructionMutex);
+        // the depth buffer is deleted together with the framebuffer, its allocation tells whether the pair is still alive
+        if (!IsAllocationLive(s_depthAllocations, HANDLE_TO_GLUINT(fbo.depthHandle), fbo.generation)) return;
+        if (!s_queuedFramebuffers.insert(fboHandle).second) return;
+        s_pendingFramebufferDestructions.push_back(PendingFramebufferDestruction{
+            .framebuffer = fboHandle,
+            .depthRenderbuffer = HANDLE_TO_GLUINT(fbo.depthHandle)
+        });
     }
 
     void GPU::BindFramebuffer(std::optional<Framebuffer> fbo) {
         if (fbo.has_value()) {
-            glBindFramebuffer(GL_FRAMEBUFFER, (GLuint) (uint64_t) fbo.value().handle);
-            glViewport(0, 0, fbo.value().width, fbo.value().height);
+            BindFramebufferHandle(HANDLE_TO_GLUINT(fbo.value().handle));
+            SetViewport(glm::ivec4(0, 0, fbo.value().width, fbo.value().height));
         } else {
             int w, h;
             glfwGetWindowSize((GLFWwindow*) info.display, &w, &h);
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glViewport(0, 0, w, h);
+            BindFramebufferHandle(0);
+            SetViewport(glm::ivec4(0, 0, w, h));
         }
     }
 
+    static std::string GetShaderExtension(ShaderType type) {
+        switch (type) {
+            case ShaderType::Vertex: return ".vert";
+            case ShaderType::Fragment: return ".frag";
+            case ShaderType::Compute: return ".compute";
+        }
+        return "";
+    }
+
     Shader GPU::GenerateShader(ShaderType type, std::string name, bool useBinaryCache) {
+        std::string code = ReadFile("shaders/gl/" + name + GetShaderExtension(type));
+        return GenerateShaderFromSource(type, name, code, useBinaryCache);
+    }
+
+    Shader GPU::GenerateShaderFromSource(ShaderType type, std::string code) {
+        return GenerateShaderFromSource(type, "generated shader", code);
+    }
+
+    Shader GPU::GenerateShaderFromSource(ShaderType type, std::string name, std::string code, bool useBinaryCache) {
         GLenum enumType = 0;
-        std::string extension = "";
         switch (type) {
             case ShaderType::Vertex: {
                 enumType = GL_VERTEX_SHADER;
-                extension = ".vert";
                 break;
             }
             case ShaderType::Fragment: {
                 enumType = GL_FRAGMENT_SHADER;
-                extension = ".frag";
                 break;
             }
             case ShaderType::Compute: {
                 enumType = GL_COMPUTE_SHADER;
-                extension = ".compute";
                 break;
             }
         }
+        std::string extension = GetShaderExtension(type);
 
-        std::string vendorCache = std::to_string(RSHash(info.renderer));
-        if (!std::filesystem::exists("shader_cache")) {
-            std::filesystem::create_directory("shader_cache");
-        } 
-        if (!std::filesystem::exists("shader_cache/gl/")) {
-            std::filesystem::create_directory("shader_cache/gl/");
-        }
-        if (!std::filesystem::exists("shader_cache/gl/" + vendorCache + "/")) {
-            std::filesystem::create_directory("shader_cache/gl/" + vendorCache + "/");
-        }
-
-        std::string code = ReadFile("shaders/gl/" + name + extension);
-        std::string codeHash = std::to_string(RSHash(code));
-
-        std::string shaderNameHash = std::to_string(RSHash(name + extension));
-        std::string nameHashPath = "shader_cache/gl/" + vendorCache + "/" + shaderNameHash + ".hash";
-        
-        bool mustReplaceBlob = false;
-
-        if (std::filesystem::exists(nameHashPath) && useBinaryCache) {
-            std::string savedCodeHash = ReadFile(nameHashPath);
-            if (savedCodeHash == codeHash) {
-                std::cout << "found cached version of " << name << std::endl;
-                std::string programBinaryString = ReadFile("shader_cache/gl/" + vendorCache + "/" + shaderNameHash + ".bin");
-                std::vector<GLbyte> programBinary(programBinaryString.begin(), programBinaryString.end());
-
-                GLint formats;
-                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        // the key covers everything the binary depends on: stage, final source text and driver identity,
+        // so identical generated shaders share one entry no matter which node produced them
+        std::string cacheKey = HashShaderSource(extension + '\0' + code + '\0' + info.renderer + '\0' + info.version);
+        std::string cachePath = "shader_cache/gl/programs/" + cacheKey + ".bin";
 
-                std::vector<GLint> binaryFormats(formats);
-                glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, binaryFormats.data());
+        if (useBinaryCache && std::filesystem::exists(cachePath)) {
+            std::string programBinaryString = ReadFile(cachePath);
+            // entries start with the binary format reported by the driver when the program was saved
+            if (programBinaryString.size() > sizeof(GLenum)) {
+                GLenum binaryFormat;
+                std::memcpy(&binaryFormat, programBinaryString.data(), sizeof(GLenum));
 
                 GLuint loadedProgram = glCreateProgram();
-                glProgramBinary(loadedProgram, (GLenum) binaryFormats[0], programBinary.data(), programBinary.size());
+                glProgramParameteri(loadedProgram, GL_PROGRAM_SEPARABLE, GL_TRUE);
+                glProgramBinary(loadedProgram, binaryFormat, programBinaryString.data() + sizeof(GLenum), (GLsizei) (programBinaryString.size() - sizeof(GLenum)));
 
                 GLint success;
                 glGetProgramiv(loadedProgram, GL_LINK_STATUS, &success);
-                if (!success) {
-                    glDeleteProgram(loadedProgram);
-                    mustReplaceBlob = true;
-                    std::cout << "failed to load cached version of " << name << std::endl;
-                } else {
+                if (success) {
                     std::cout << "successfully loaded cached version of " << name << std::endl;
+                    s_liveShaders++;
                     return Shader(type, GLUINT_TO_HANDLE(loadedProgram));
                 }
+                glDeleteProgram(loadedProgram);
+                std::cout << "failed to load cached version of " << name << std::endl;
             }
         }
 
@@ -476,44 +835,66 @@ namespace Raster {
             throw std::runtime_error(std::string(log.data()));
         }
 
-        if (std::filesystem::exists(nameHashPath) && useBinaryCache) {
-            std::string savedHash = ReadFile(nameHashPath);
-            if (savedHash != codeHash) {
-                mustReplaceBlob = true;
+        if (useBinaryCache) {
+            GLint binaryLength = 0;
+            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+            if (binaryLength > 0) {
+                GLenum binaryFormat;
+                std::string programBinary(sizeof(GLenum) + binaryLength, '\0');
+                glGetProgramBinary(program, binaryLength, nullptr, &binaryFormat, programBinary.data() + sizeof(GLenum));
+                std::memcpy(programBinary.data(), &binaryFormat, sizeof(GLenum));
+
+                // background compilers may get here at the same time
+                std::error_code errorCode;
+                std::filesystem::create_directories("shader_cache/gl/programs/", errorCode);
+                WriteFile(cachePath + ".tmp" + std::to_string(program), programBinary);
+                std::filesystem::rename(cachePath + ".tmp" + std::to_string(program), cachePath, errorCode);
+                std::cout << "saving cached program binary of " << name << std::endl;
             }
-        } else {
-            mustReplaceBlob = true;
         }
 
-        if (mustReplaceBlob && useBinaryCache) {
-            GLint formatCount;
-            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
-
-            std::vector<GLint> formats(formatCount);
-            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
-
-            GLint length;
-            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
-
-            GLenum binaryFormats;
-            std::vector<GLbyte> programBinary(length);
-            glGetProgramBinary(program, length, nullptr, &binaryFormats, programBinary.data());
+        s_liveShaders++;
+        return Shader(type, GLUINT_TO_HANDLE(program));
+    }
 
-            WriteFile(nameHashPath, codeHash);
-            WriteFile("shader_cache/gl/" + vendorCache + "/" + shaderNameHash + ".bin", std::string(programBinary.begin(), programBinary.end()));
-            std::cout << "saving cached program binary of " << name << std::endl;
+    // resolves every active uniform of the program once, so later lookups never reach the driver
+    static void PreloadShaderUniforms(Shader shader) {
+        if (!shader.handle || shaderRegistry.find(shader.handle) != shaderRegistry.end()) return;
+        auto& uniformsMap = shaderRegistry[shader.handle];
+        GLuint program = HANDLE_TO_GLUINT(shader.handle);
+
+        GLint uniformsCount = 0, maxNameLength = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformsCount);
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+        std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+        for (GLint i = 0; i < uniformsCount; i++) {
+            GLsizei length;
+            GLint size;
+            GLenum type;
+            glGetActiveUniform(program, (GLuint) i, nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+            std::string name(nameBuffer.data(), length);
+            int location = glGetUniformLocation(program, name.c_str());
+            // members of uniform blocks have no location
+            if (location < 0) continue;
+            uniformsMap[name] = location;
+            if (name.size() > 3 && name.substr(name.size() - 3) == "[0]") {
+                uniformsMap[name.substr(0, name.size() - 3)] = location;
+            }
         }
-
-        return Shader(type, GLUINT_TO_HANDLE(program));
     }
 
     Pipeline GPU::GeneratePipeline(Shader vertexShader, Shader fragmentShader) {
         GLuint pipeline;
         glGenProgramPipelines(1, &pipeline);
         glBindProgramPipeline(pipeline);
+        if (IsStateShadowed()) s_state.pipeline = pipeline;
         glUseProgramStages(pipeline, GL_VERTEX_SHADER_BIT, HANDLE_TO_GLUINT(vertexShader.handle));
         glUseProgramStages(pipeline, GL_FRAGMENT_SHADER_BIT, HANDLE_TO_GLUINT(fragmentShader.handle));
 
+        PreloadShaderUniforms(vertexShader);
+        PreloadShaderUniforms(fragmentShader);
+
+        s_livePipelines++;
         Pipeline result;
         result.vertex = vertexShader;
         result.fragment = fragmentShader;
@@ -521,12 +902,29 @@ namespace Raster {
         return result;
     }
 
+    Pipeline GPU::GenerateComputePipeline(Shader computeShader) {
+        GLuint pipeline;
+        glGenProgramPipelines(1, &pipeline);
+        glBindProgramPipeline(pipeline);
+        if (IsStateShadowed()) s_state.pipeline = pipeline;
+        glUseProgramStages(pipeline, GL_COMPUTE_SHADER_BIT, HANDLE_TO_GLUINT(computeShader.handle));
+
+        PreloadShaderUniforms(computeShader);
+
+        s_livePipelines++;
+        Pipeline result;
+        result.compute = computeShader;
+        result.handle = GLUINT_TO_HANDLE(pipeline);
+        return result;
+    }
+
     void GPU::DestroyShader(Shader shader) {
         if (!shader.handle) return;
         if (shaderRegistry.find(shader.handle) != shaderRegistry.end()) {
             shaderRegistry.erase(shader.handle);
         }
         glDeleteProgram(HANDLE_TO_GLUINT(shader.handle));
+        s_liveShaders--;
     }
 
     void GPU::DestroyPipeline(Pipeline pipeline) {
@@ -534,56 +932,166 @@ namespace Raster {
         DestroyShader(pipeline.fragment);
         DestroyShader(pipeline.compute);
         GLuint handle = HANDLE_TO_GLUINT(pipeline.handle);
+        if (!handle) return;
         glDeleteProgramPipelines(1, &handle);
+        s_livePipelines--;
+        if (IsStateShadowed() && s_state.pipeline == handle) s_state.pipeline = 0;
     }
 
-    int GPU::GetShaderUniformLocation(Shader shader, std::string name) {
-        if (shaderRegistry.find(shader.handle) == shaderRegistry.end()) {
-            shaderRegistry[shader.handle] = {};
-        }
+    int GPU::GetShaderUniformLocation(Shader shader, const std::string& name) {
         auto& uniformsMap = shaderRegistry[shader.handle];
-        if (uniformsMap.find(name) != uniformsMap.end()) {
-            if (uniformsMap[name] < 0) {
-            }
-            return uniformsMap[name];
+        auto uniformIterator = uniformsMap.find(name);
+        if (uniformIterator != uniformsMap.end()) {
+            return uniformIterator->second;
         }
-        uniformsMap[name] = glGetUniformLocation(HANDLE_TO_GLUINT(shader.handle), name.c_str());
-        return uniformsMap[name];
+        int location = glGetUniformLocation(HANDLE_TO_GLUINT(shader.handle), name.c_str());
+        uniformsMap[name] = location;
+        return location;
+    }
+
+    UniformHandle GPU::GetUniformHandle(Shader shader, const std::string& name) {
+        UniformHandle handle;
+        handle.shader = shader.handle;
+        handle.location = GetShaderUniformLocation(shader, name);
+        return handle;
+    }
+
+    void GPU::SetShaderUniform(UniformHandle handle, int i) {
+        glProgramUniform1i(HANDLE_TO_GLUINT(handle.shader), handle.location, i);
+    }
+
+    void GPU::SetShaderUniform(UniformHandle handle, glm::vec4 vec) {
+        glProgramUniform4f(HANDLE_TO_GLUINT(handle.shader), handle.location, vec.x, vec.y, vec.z, vec.w);
+    }
+
+    void GPU::SetShaderUniform(UniformHandle handle, glm::vec2 vec) {
+        glProgramUniform2f(HANDLE_TO_GLUINT(handle.shader), handle.location, vec.x, vec.y);
+    }
+
+    void GPU::SetShaderUniform(UniformHandle handle, float f) {
+        glProgramUniform1f(HANDLE_TO_GLUINT(handle.shader), handle.location, f);
+    }
+
+    void GPU::SetShaderUniform(UniformHandle handle, glm::mat4 mat) {
+        glProgramUniformMatrix4fv(HANDLE_TO_GLUINT(handle.shader), handle.location, 1, GL_FALSE, &mat[0][0]);
+    }
+
+    UniformBlock GPU::UploadUniformBlock(const void* data, uint32_t size) {
+        uint32_t offset = (s_uniformRingOffset + s_uniformRingAlignment - 1) / s_uniformRingAlignment * s_uniformRingAlignment;
+        if (offset + size > UNIFORM_RING_SIZE) offset = 0;
+        glBindBuffer(GL_UNIFORM_BUFFER, s_uniformRing);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        s_uniformRingOffset = offset + size;
+
+        UniformBlock block;
+        block.buffer = GLUINT_TO_HANDLE(s_uniformRing);
+        block.offset = offset;
+        block.size = size;
+        return block;
     }
 
-    void GPU::SetShaderUniform(Shader shader, std::string name, int i) {
+    void GPU::BindUniformBlock(UniformBlock block, int binding) {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, HANDLE_TO_GLUINT(block.buffer), block.offset, block.size);
+    }
+
+    void GPU::SetShaderUniform(Shader shader, const std::string& name, int i) {
         glProgramUniform1i(HANDLE_TO_GLUINT(shader.handle), GetShaderUniformLocation(shader, name), i);
     }
 
-    void GPU::SetShaderUniform(Shader shader, std::string name, glm::vec4 vec) {
+    void GPU::SetShaderUniform(Shader shader, const std::string& name, glm::vec4 vec) {
         glProgramUniform4f(HANDLE_TO_GLUINT(shader.handle), GetShaderUniformLocation(shader, name), vec.x, vec.y, vec.z, vec.w);
     }
 
-    void GPU::SetShaderUniform(Shader shader, std::string name, glm::vec2 vec) {
+    void GPU::SetShaderUniform(Shader shader, const std::string& name, glm::vec2 vec) {
         glProgramUniform2f(HANDLE_TO_GLUINT(shader.handle), GetShaderUniformLocation(shader, name), vec.x, vec.y);
     }
 
-    void GPU::SetShaderUniform(Shader shader, std::string name, float f) {
+    void GPU::SetShaderUniform(Shader shader, const std::string& name, float f) {
         glProgramUniform1f(HANDLE_TO_GLUINT(shader.handle), GetShaderUniformLocation(shader, name), f);
     }
 
-    void GPU::SetShaderUniform(Shader shader, std::string name, glm::mat4 mat) {
+    void GPU::SetShaderUniform(Shader shader, const std::string& name, glm::mat4 mat) {
         glProgramUniformMatrix4fv(HANDLE_TO_GLUINT(shader.handle), GetShaderUniformLocation(shader, name), 1, GL_FALSE, &mat[0][0]);
     }
 
     void GPU::BindPipeline(Pipeline pipeline) {
+        GLuint handle = HANDLE_TO_GLUINT(pipeline.handle);
+        if (IsStateShadowed() && s_state.pipeline == handle) {
+            s_statistics.skippedCalls++;
+            return;
+        }
         glUseProgram(0);
-        glBindProgramPipeline(HANDLE_TO_GLUINT(pipeline.handle));
+        glBindProgramPipeline(handle);
+        if (IsStateShadowed()) {
+            s_state.pipeline = handle;
+            s_statistics.pipelineBinds++;
+        }
     }
 
     void GPU::ClearFramebuffer(float r, float g, float b, float a) {
         glClearColor(r, g, b, a);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        s_statistics.clears++;
+    }
+
+    void GPU::BlitFramebuffer(Framebuffer base, Texture texture, int attachment, std::optional<glm::ivec4> region) {
+        glm::ivec4 rect = region.value_or(glm::ivec4(0, 0, base.width, base.height));
+        if (rect.z <= 0 || rect.w <= 0) return;
+        glCopyImageSubData(HANDLE_TO_GLUINT(texture.handle), GL_TEXTURE_2D, 0, rect.x, rect.y, 0,
+                           HANDLE_TO_GLUINT(base.attachments[attachment].handle), GL_TEXTURE_2D, 0, rect.x, rect.y, 0, rect.z, rect.w, 1);
     }
 
-    void GPU::BlitFramebuffer(Framebuffer base, Texture texture, int attachment) {
-        glCopyImageSubData(HANDLE_TO_GLUINT(texture.handle), GL_TEXTURE_2D, 0, 0, 0, 0,
-                           HANDLE_TO_GLUINT(base.attachments[attachment].handle), GL_TEXTURE_2D, 0, 0, 0, 0, base.width, base.height, 1);
+    void GPU::ResampleFramebuffer(Framebuffer target, Framebuffer source, int attachment) {
+        GLuint targetHandle = HANDLE_TO_GLUINT(target.handle);
+        GLuint sourceHandle = HANDLE_TO_GLUINT(source.handle);
+        // the scissor test would clip the blit
+        SetCapability(GL_SCISSOR_TEST, s_state.scissorTest, false);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceHandle);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetHandle);
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + attachment);
+        std::vector<GLenum> drawBuffers(target.attachments.size(), GL_NONE);
+        drawBuffers[attachment] = GL_COLOR_ATTACHMENT0 + attachment;
+        glDrawBuffers(drawBuffers.size(), drawBuffers.data());
+
+        glBlitFramebuffer(0, 0, source.width, source.height, 0, 0, target.width, target.height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+        // both framebuffers get back the read and draw buffers GenerateFramebuffer() gave them
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        for (int i = 0; i < (int) drawBuffers.size(); i++) {
+            drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+        }
+        glDrawBuffers(drawBuffers.size(), drawBuffers.data());
+        glBindFramebuffer(GL_FRAMEBUFFER, targetHandle);
+        if (IsStateShadowed()) s_state.framebuffer = targetHandle;
+    }
+
+    void GPU::SetScissor(std::optional<glm::ivec4> rect) {
+        if (!rect.has_value()) {
+            SetCapability(GL_SCISSOR_TEST, s_state.scissorTest, false);
+            return;
+        }
+        SetCapability(GL_SCISSOR_TEST, s_state.scissorTest, true);
+        auto value = glm::ivec4(rect.value().x, rect.value().y, std::max(rect.value().z, 0), std::max(rect.value().w, 0));
+        if (IsStateShadowed() && s_state.scissor == value) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        glScissor(value.x, value.y, value.z, value.w);
+        if (IsStateShadowed()) {
+            s_state.scissor = value;
+            s_statistics.stateChanges++;
+        }
+    }
+
+    void GPU::ReadPixels(Framebuffer fbo, int attachment, glm::ivec4 rect, void* pixels, TexturePrecision precision) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, HANDLE_TO_GLUINT(fbo.handle));
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + attachment);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(rect.x, rect.y, rect.z, rect.w, GL_RGBA, precision == TexturePrecision::Usual ? GL_UNSIGNED_BYTE : GL_FLOAT, pixels);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        // GL_FRAMEBUFFER binds set both targets, the read target goes back to what the shadow expects
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, IsStateShadowed() && s_state.framebuffer != UNKNOWN_GL_STATE ? s_state.framebuffer : 0);
     }
 
     void GPU::BlitTexture(Texture base, Texture blit) {
@@ -597,8 +1105,9 @@ namespace Raster {
 
         Sampler result;
         result.handle = GLUINT_TO_HANDLE(sampler);
+        s_liveSamplers++;
 
-        SetSamplerTextureFilteringMode(result, TextureFilteringOperation::Minify, TextureFilteringMode::Linear);
+        SetSamplerTextureFilteringMode(result, TextureFilteringOperation::Magnify, TextureFilteringMode::Linear);
         SetSamplerTextureFilteringMode(result, TextureFilteringOperation::Minify, TextureFilteringMode::Linear);
 
         SetSamplerTextureWrappingMode(result, TextureWrappingAxis::S, TextureWrappingMode::Repeat);
@@ -607,8 +1116,32 @@ namespace Raster {
         return result;
     }
 
+    Sampler GPU::GetSampler(TextureWrappingMode wrapping, TextureFilteringMode filtering) {
+        int key = static_cast<int>(wrapping) * 2 + static_cast<int>(filtering);
+        auto cachedSampler = s_samplerCache.find(key);
+        if (cachedSampler != s_samplerCache.end()) return cachedSampler->second;
+
+        Sampler sampler = GenerateSampler();
+        SetSamplerTextureFilteringMode(sampler, TextureFilteringOperation::Magnify, filtering);
+        SetSamplerTextureFilteringMode(sampler, TextureFilteringOperation::Minify, filtering);
+        SetSamplerTextureWrappingMode(sampler, TextureWrappingAxis::S, wrapping);
+        SetSamplerTextureWrappingMode(sampler, TextureWrappingAxis::T, wrapping);
+        s_samplerCache[key] = sampler;
+        return sampler;
+    }
+
     void GPU::BindSampler(std::optional<Sampler> sampler, int unit) {
-        glBindSampler(unit, HANDLE_TO_GLUINT((sampler.value_or(0)).handle));
+        GLuint handle = HANDLE_TO_GLUINT((sampler.value_or(0)).handle);
+        bool shadowed = IsStateShadowed() && unit >= 0 && unit < SHADOWED_TEXTURE_UNITS;
+        if (shadowed && s_state.samplers[unit] == handle) {
+            s_statistics.skippedCalls++;
+            return;
+        }
+        glBindSampler(unit, handle);
+        if (shadowed) {
+            s_state.samplers[unit] = handle;
+            s_statistics.samplerBinds++;
+        }
     }
 
     void GPU::SetSamplerTextureFilteringMode(Sampler& sampler, TextureFilteringOperation operation, TextureFilteringMode mode) {
@@ -633,15 +1166,93 @@ namespace Raster {
 
     void GPU::DestroySampler(Sampler& sampler) {
         GLuint handle = HANDLE_TO_GLUINT(sampler.handle);
+        if (!handle) return;
         glDeleteSamplers(1, &handle);
+        s_liveSamplers--;
+        if (IsStateShadowed()) {
+            for (auto& boundSampler : s_state.samplers) {
+                if (boundSampler == handle) boundSampler = 0;
+            }
+        }
         sampler = Sampler();
     }
 
     void GPU::DrawArrays(int count) {
         glDrawArrays(GL_TRIANGLES, 0, count);
+        s_statistics.drawCalls++;
+    }
+
+    void GPU::BindImageTexture(Texture texture, int unit, ImageAccess access) {
+        GLenum accessMode = GL_READ_WRITE;
+        if (access == ImageAccess::Read) accessMode = GL_READ_ONLY;
+        if (access == ImageAccess::Write) accessMode = GL_WRITE_ONLY;
+        glBindImageTexture(unit, HANDLE_TO_GLUINT(texture.handle), 0, GL_FALSE, 0, accessMode, InterpretTextureInfo(texture.channels, texture.precision));
+        s_statistics.textureBinds++;
+    }
+
+    void GPU::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) {
+        glDispatchCompute(groupsX, groupsY, groupsZ);
+        // image stores are incoherent, later passes sample or render into the written textures
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+        s_statistics.computeDispatches++;
+    }
+
+    void GPU::SetBlendingEnabled(bool enabled) {
+        SetCapability(GL_BLEND, s_state.blending, enabled);
+    }
+
+    GPUFrameStatistics GPU::GetFrameStatistics() {
+        return s_lastStatistics;
+    }
+
+    GPUMemoryUsage GPU::GetMemoryUsage() {
+        GPUMemoryUsage usage{};
+        std::lock_guard<std::mutex> guard(s_destructionMutex);
+        for (int i = 0; i < GPU_MEMORY_OWNERS_COUNT; i++) {
+            usage.bytes[i] = s_allocatedBytes[i];
+            usage.total += s_allocatedBytes[i];
+        }
+        return usage;
+    }
+
+    GPUMemoryOwner GPU::GetMemoryOwner() {
+        return s_memoryOwner;
+    }
+
+    uint64_t GPU::GetTextureMemory(Texture texture) {
+        if (texture.compressed) {
+            // 8 bytes per 4x4 block for ETC2, twice that with EAC alpha
+            uint64_t blocks = (uint64_t) ((texture.width + 3) / 4) * ((texture.height + 3) / 4);
+            return blocks * (texture.channels == 4 ? 16 : 8);
+        }
+        uint64_t bytesPerChannel = 1;
+        if (texture.precision == TexturePrecision::Half) bytesPerChannel = 2;
+        if (texture.precision == TexturePrecision::Full) bytesPerChannel = 4;
+        // three channel formats are padded to four by most drivers
+        uint64_t channels = texture.channels == 3 ? 4 : texture.channels;
+        return (uint64_t) texture.width * texture.height * channels * bytesPerChannel;
+    }
+
+    GPUObjectCounters GPU::GetObjectCounters() {
+        GPUObjectCounters counters;
+        counters.textures = s_liveTextures;
+        counters.framebuffers = s_liveFramebuffers;
+        counters.samplers = s_liveSamplers;
+        counters.shaders = s_liveShaders;
+        counters.pipelines = s_livePipelines;
+        std::lock_guard<std::mutex> guard(s_destructionMutex);
+        counters.pendingDestructions = (int) (s_pendingTextureDestructions.size() + s_pendingFramebufferDestructions.size());
+        return counters;
     }
 
     void GPU::Terminate() {
+        glDeleteBuffers(1, &s_uniformRing);
+        for (auto& cachedSampler : s_samplerCache) {
+            DestroySampler(cachedSampler.second);
+        }
+        s_samplerCache.clear();
+        ExecutePendingDestructions();
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -0,0 +1,233 @@
+#include "gpu/shader_compiler.h"
+
+// background contexts are cheap, but drivers rarely compile more than a few programs in parallel
+#define SHADER_COMPILER_MAX_WORKERS 4
+
+namespace Raster {
+    bool ShaderCompiler::s_running = false;
+    std::mutex ShaderCompiler::s_tasksMutex;
+    std::condition_variable ShaderCompiler::s_tasksCondition;
+    std::deque<std::function<void()>> ShaderCompiler::s_tasks;
+    std::vector<std::thread> ShaderCompiler::s_workers;
+    std::atomic<int> ShaderCompiler::s_pendingCount = 0;
+    std::unordered_map<std::string, ShaderRequest> ShaderCompiler::s_sharedShaders;
+    std::vector<std::shared_future<Shader>> ShaderCompiler::s_discarded;
+
+    static bool IsFutureReady(const std::shared_future<Shader>& t_future) {
+        return t_future.valid() && t_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    ShaderRequest::ShaderRequest() {
+        this->owned = false;
+    }
+
+    ShaderRequest::ShaderRequest(std::shared_future<Shader> t_shader, bool t_owned) {
+        this->shader = t_shader;
+        this->owned = t_owned;
+    }
+
+    PendingPipeline::PendingPipeline() {
+        this->m_failed = false;
+    }
+
+    PendingPipeline::PendingPipeline(ShaderRequest t_vertex, ShaderRequest t_fragment) {
+        this->m_vertex = t_vertex;
+        this->m_fragment = t_fragment;
+        this->m_failed = false;
+    }
+
+    PendingPipeline::PendingPipeline(ShaderRequest t_compute) {
+        this->m_compute = t_compute;
+        this->m_failed = false;
+    }
+
+    bool PendingPipeline::IsRequested() {
+        return (m_vertex.has_value() && m_fragment.has_value()) || m_compute.has_value();
+    }
+
+    std::optional<Pipeline> PendingPipeline::Get() {
+        if (m_pipeline.has_value()) return m_pipeline;
+        ShaderCompiler::CollectDiscarded();
+        if (m_failed || !IsRequested()) return std::nullopt;
+
+        try {
+            if (m_compute.has_value()) {
+                auto& compute = m_compute.value().shader;
+                if (!IsFutureReady(compute)) return std::nullopt;
+                m_pipeline = GPU::GenerateComputePipeline(compute.get());
+            } else {
+                auto& vertex = m_vertex.value().shader;
+                auto& fragment = m_fragment.value().shader;
+                if (!IsFutureReady(vertex) || !IsFutureReady(fragment)) return std::nullopt;
+                m_pipeline = GPU::GeneratePipeline(vertex.get(), fragment.get());
+            }
+        } catch (std::exception& ex) {
+            std::cout << "failed to compile pipeline: " << ex.what() << std::endl;
+            this->m_failed = true;
+        }
+        return m_pipeline;
+    }
+
+    void PendingPipeline::Destroy() {
+        if (m_pipeline.has_value()) {
+            auto pipeline = m_pipeline.value();
+            // shared programs stay alive for every other pipeline using them
+            if (!m_vertex.has_value() || !m_vertex.value().owned) pipeline.vertex = Shader();
+            if (!m_fragment.has_value() || !m_fragment.value().owned) pipeline.fragment = Shader();
+            if (!m_compute.has_value() || !m_compute.value().owned) pipeline.compute = Shader();
+            GPU::DestroyPipeline(pipeline);
+        } else {
+            for (const auto& request : {m_vertex, m_fragment, m_compute}) {
+                if (request.has_value() && request.value().owned) {
+                    ShaderCompiler::Discard(request.value().shader);
+                }
+            }
+        }
+        this->m_vertex = std::nullopt;
+        this->m_fragment = std::nullopt;
+        this->m_compute = std::nullopt;
+        this->m_pipeline = std::nullopt;
+        this->m_failed = false;
+    }
+
+    void ShaderCompiler::Initialize() {
+        int workersCount = std::clamp((int) std::thread::hardware_concurrency() / 2, 1, SHADER_COMPILER_MAX_WORKERS);
+        std::cout << "booting up shader compiler with " << workersCount << " background contexts" << std::endl;
+        s_running = true;
+        for (int i = 0; i < workersCount; i++) {
+            // contexts have to be created on the main thread
+            void* context = GPU::ReserveContext();
+            if (!context) break;
+            s_workers.push_back(std::thread(ShaderCompiler::WorkerLogic, context));
+        }
+    }
+
+    void ShaderCompiler::Terminate() {
+        {
+            std::lock_guard<std::mutex> lg(s_tasksMutex);
+            s_running = false;
+            s_tasks.clear();
+        }
+        s_tasksCondition.notify_all();
+        for (auto& worker : s_workers) {
+            worker.join();
+        }
+        s_workers.clear();
+    }
+
+    void ShaderCompiler::WarmUp() {
+        std::string shadersPath = GPU::GetShadersPath();
+        if (!std::filesystem::exists(shadersPath)) return;
+        for (auto& entry : std::filesystem::recursive_directory_iterator(shadersPath)) {
+            if (!entry.is_regular_file()) continue;
+            auto path = entry.path();
+            auto extension = path.extension().string();
+            std::string name = path.lexically_relative(shadersPath).replace_extension().generic_string();
+            if (extension == ".vert") {
+                RequestShader(ShaderType::Vertex, name);
+            } else if (extension == ".frag" && path.stem() == "shader") {
+                RequestShader(ShaderType::Fragment, name);
+            } else if (extension == ".compute" && path.stem() == "shader") {
+                RequestShader(ShaderType::Compute, name);
+            }
+        }
+    }
+
+    ShaderRequest ShaderCompiler::RequestShader(ShaderType t_type, std::string t_name) {
+        std::string key = std::to_string((int) t_type) + ":" + t_name;
+        if (s_sharedShaders.find(key) != s_sharedShaders.end()) return s_sharedShaders[key];
+        auto request = Enqueue([t_type, t_name]() {
+            return GPU::GenerateShader(t_type, t_name);
+        }, false);
+        s_sharedShaders[key] = request;
+        return request;
+    }
+
+    ShaderRequest ShaderCompiler::RequestShaderFromSource(ShaderType t_type, std::string t_name, std::string t_code) {
+        return Enqueue([t_type, t_name, t_code]() {
+            return GPU::GenerateShaderFromSource(t_type, t_name, t_code);
+        }, true);
+    }
+
+    ShaderRequest ShaderCompiler::Ready(Shader t_shader) {
+        std::promise<Shader> promise;
+        promise.set_value(t_shader);
+        return ShaderRequest(promise.get_future().share(), false);
+    }
+
+    PendingPipeline ShaderCompiler::RequestPipeline(ShaderRequest t_vertex, ShaderRequest t_fragment) {
+        return PendingPipeline(t_vertex, t_fragment);
+    }
+
+    PendingPipeline ShaderCompiler::RequestComputePipeline(ShaderRequest t_compute) {
+        return PendingPipeline(t_compute);
+    }
+
+    int ShaderCompiler::GetPendingCount() {
+        return s_pendingCount;
+    }
+
+    ShaderRequest ShaderCompiler::Enqueue(std::function<Shader()> t_compile, bool t_owned) {
+        auto promise = std::make_shared<std::promise<Shader>>();
+        ShaderRequest request(promise->get_future().share(), t_owned);
+        auto task = [promise, t_compile]() {
+            try {
+                promise->set_value(t_compile());
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        };
+
+        // without background contexts the program is compiled right away, as it used to be
+        if (s_workers.empty()) {
+            task();
+            return request;
+        }
+
+        s_pendingCount++;
+        {
+            std::lock_guard<std::mutex> lg(s_tasksMutex);
+            s_tasks.push_back(task);
+        }
+        s_tasksCondition.notify_one();
+        return request;
+    }
+
+    void ShaderCompiler::WorkerLogic(void* t_context) {
+        GPU::SetCurrentContext(t_context);
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(s_tasksMutex);
+                s_tasksCondition.wait(lock, []() { return !s_running || !s_tasks.empty(); });
+                if (!s_running) break;
+                task = s_tasks.front();
+                s_tasks.pop_front();
+            }
+            task();
+            // the main context may only use the program once the driver has finished with it
+            GPU::Flush();
+            s_pendingCount--;
+        }
+        GPU::SetCurrentContext(nullptr);
+    }
+
+    void ShaderCompiler::Discard(std::shared_future<Shader> t_shader) {
+        s_discarded.push_back(t_shader);
+    }
+
+    void ShaderCompiler::CollectDiscarded() {
+        if (s_discarded.empty()) return;
+        std::vector<std::shared_future<Shader>> stillCompiling;
+        for (auto& shader : s_discarded) {
+            if (!IsFutureReady(shader)) {
+                stillCompiling.push_back(shader);
+                continue;
+            }
+            try {
+                GPU::DestroyShader(shader.get());
+            } catch (...) {}
+        }
+        s_discarded = stillCompiling;
+    }
+};
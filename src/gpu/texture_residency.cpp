@@ -0,0 +1,79 @@
+#include "gpu/texture_residency.h"
+
+namespace Raster {
+    uint64_t TextureResidency::s_budget = 0;
+    std::mutex TextureResidency::s_mutex;
+    std::unordered_map<TextureResidencyID, TextureResidencyEntry> TextureResidency::s_entries;
+    TextureResidencyID TextureResidency::s_nextID = 1;
+    uint64_t TextureResidency::s_frame = 0;
+    int TextureResidency::s_evictedCount = 0;
+
+    TextureResidencyID TextureResidency::Register(Texture t_texture) {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        TextureResidencyID id = s_nextID++;
+        s_entries[id] = TextureResidencyEntry{
+            .texture = t_texture,
+            .lastUsedFrame = s_frame
+        };
+        return id;
+    }
+
+    void TextureResidency::Unregister(TextureResidencyID& t_id) {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        s_entries.erase(t_id);
+        t_id = 0;
+    }
+
+    bool TextureResidency::Touch(TextureResidencyID t_id) {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        auto entry = s_entries.find(t_id);
+        if (entry == s_entries.end()) return false;
+        entry->second.lastUsedFrame = s_frame;
+        return true;
+    }
+
+    void TextureResidency::BeginFrame() {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        s_frame++;
+        if (!s_budget) return;
+
+        uint64_t usage = GPU::GetMemoryUsage().total;
+        if (usage <= s_budget) return;
+
+        std::vector<std::pair<uint64_t, TextureResidencyID>> candidates;
+        for (auto& entry : s_entries) {
+            if (s_frame - entry.second.lastUsedFrame <= TEXTURE_RESIDENCY_PROTECTED_FRAMES) continue;
+            candidates.push_back({entry.second.lastUsedFrame, entry.first});
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // destruction is deferred, the freed memory only shows up in GPU::GetMemoryUsage() next frame
+        for (auto& candidate : candidates) {
+            if (usage <= s_budget) break;
+            auto& texture = s_entries[candidate.second].texture;
+            usage -= std::min(usage, GPU::GetTextureMemory(texture));
+            GPU::DestroyTexture(texture);
+            s_entries.erase(candidate.second);
+            s_evictedCount++;
+        }
+    }
+
+    int TextureResidency::GetResidentCount() {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        return (int) s_entries.size();
+    }
+
+    uint64_t TextureResidency::GetResidentMemory() {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        uint64_t memory = 0;
+        for (auto& entry : s_entries) {
+            memory += GPU::GetTextureMemory(entry.second.texture);
+        }
+        return memory;
+    }
+
+    int TextureResidency::GetEvictedCount() {
+        std::lock_guard<std::mutex> guard(s_mutex);
+        return s_evictedCount;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "image/disk_cache.h"
+#include "common/content_store.h"
+#include <cstring>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#define RASTER_IMAGE_CACHE_VERSION 1
+
+namespace Raster {
+
+    std::string ImageDiskCache::s_cacheDirectory = "image_cache";
+    std::uintmax_t ImageDiskCache::s_budget = (std::uintmax_t) 4096 * 1024 * 1024;
+    std::mutex ImageDiskCache::m_cacheMutex;
+
+    // pixel data starts right after this header, 64 bytes keep it well aligned for uploads
+    struct ImageDiskCacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t width, height;
+        uint32_t originalWidth, originalHeight;
+        int32_t channels;
+        int32_t precision;
+        uint64_t dataSize;
+        uint8_t reserved[24];
+    };
+
+    static_assert(sizeof(ImageDiskCacheHeader) == 64);
+
+    MappedImageFile::MappedImageFile(std::string t_path) {
+        this->data = nullptr;
+        this->size = 0;
+#ifdef _WIN32
+        this->m_fileHandle = nullptr;
+        this->m_mappingHandle = nullptr;
+
+        HANDLE file = CreateFileA(t_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return;
+        }
+        this->m_fileHandle = file;
+        this->m_mappingHandle = mapping;
+        this->data = (uint8_t*) view;
+        this->size = (size_t) fileSize.QuadPart;
+#else
+        this->m_fileDescriptor = open(t_path.c_str(), O_RDONLY);
+        if (m_fileDescriptor < 0) return;
+        struct stat fileStat;
+        if (fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0) return;
+        void* view = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+        if (view == MAP_FAILED) return;
+        this->data = (uint8_t*) view;
+        this->size = (size_t) fileStat.st_size;
+#endif
+    }
+
+    MappedImageFile::~MappedImageFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (m_mappingHandle) CloseHandle((HANDLE) m_mappingHandle);
+        if (m_fileHandle) CloseHandle((HANDLE) m_fileHandle);
+#else
+        if (data) munmap(data, size);
+        if (m_fileDescriptor >= 0) close(m_fileDescriptor);
+#endif
+    }
+
+    bool MappedImageFile::IsValid() {
+        return data != nullptr;
+    }
+
+    std::optional<std::string> ImageDiskCache::GetKey(std::string t_path, ImageLoaderOptions t_options) {
+        auto hashCandidate = ContentStore::HashFile(t_path);
+        if (!hashCandidate.has_value()) return std::nullopt;
+
+        std::string options = FormatString("%i_%s", t_options.part, t_options.layer.has_value() ? t_options.layer.value().c_str() : "*");
+        if (t_options.targetResolution.has_value()) {
+            auto& targetResolution = t_options.targetResolution.value();
+            options += FormatString("_%ix%i", (int) targetResolution.x, (int) targetResolution.y);
+        }
+        return FormatString("%s_%u", hashCandidate.value().c_str(), (unsigned int) std::hash<std::string>{}(options));
+    }
+
+    std::string ImageDiskCache::GetEntryPath(std::string t_key) {
+        return FormatString("%s/%s.raw", s_cacheDirectory.c_str(), t_key.c_str());
+    }
+
+    std::optional<Image> ImageDiskCache::ReadRawImage(std::string t_path) {
+        if (!std::filesystem::exists(t_path)) return std::nullopt;
+
+        auto mapping = std::make_shared<MappedImageFile>(t_path);
+        if (!mapping->IsValid() || mapping->size < sizeof(ImageDiskCacheHeader)) return std::nullopt;
+
+        ImageDiskCacheHeader header;
+        std::memcpy(&header, mapping->data, sizeof(header));
+        if (std::memcmp(header.magic, "RIMG", 4) != 0 || header.version != RASTER_IMAGE_CACHE_VERSION) return std::nullopt;
+        if (mapping->size < sizeof(ImageDiskCacheHeader) + header.dataSize) return std::nullopt;
+
+        Image result;
+        result.width = header.width;
+        result.height = header.height;
+        result.originalWidth = header.originalWidth;
+        result.originalHeight = header.originalHeight;
+        result.channels = header.channels;
+        result.precision = (ImagePrecision) header.precision;
+        result.mapping = mapping;
+        result.mappingOffset = sizeof(ImageDiskCacheHeader);
+        result.mappingSize = header.dataSize;
+
+        return result;
+    }
+
+    bool ImageDiskCache::WriteRawImage(std::string t_path, Image& t_image) {
+        ImageDiskCacheHeader header = {};
+        std::memcpy(header.magic, "RIMG", 4);
+        header.version = RASTER_IMAGE_CACHE_VERSION;
+        header.width = t_image.width;
+        header.height = t_image.height;
+        header.originalWidth = t_image.originalWidth;
+        header.originalHeight = t_image.originalHeight;
+        header.channels = t_image.channels;
+        header.precision = (int32_t) t_image.precision;
+        header.dataSize = t_image.GetDataSize();
+
+        // written under a temporary name first, so readers never map a partial file
+        std::string temporaryPath = t_path + ".tmp";
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary);
+            if (!stream.is_open()) return false;
+            stream.write((const char*) &header, sizeof(header));
+            stream.write((const char*) t_image.GetData(), header.dataSize);
+            if (!stream.good()) {
+                stream.close();
+                std::filesystem::remove(temporaryPath);
+                return false;
+            }
+        }
+        std::error_code errorCode;
+        std::filesystem::rename(temporaryPath, t_path, errorCode);
+        if (errorCode) {
+            std::filesystem::remove(temporaryPath, errorCode);
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<Image> ImageDiskCache::Load(std::string t_key) {
+        std::string entryPath = GetEntryPath(t_key);
+        auto imageCandidate = ReadRawImage(entryPath);
+        if (!imageCandidate.has_value()) return std::nullopt;
+
+        // touching the entry keeps recently used images at the end of the eviction order
+        std::error_code errorCode;
+        std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), errorCode);
+
+        return imageCandidate;
+    }
+
+    void ImageDiskCache::Store(std::string t_key, Image& t_image) {
+        std::lock_guard<std::mutex> lg(m_cacheMutex);
+        if (!std::filesystem::exists(s_cacheDirectory)) {
+            std::filesystem::create_directories(s_cacheDirectory);
+        }
+
+        if (WriteRawImage(GetEntryPath(t_key), t_image)) {
+            TrimUnlocked();
+        }
+    }
+
+    void ImageDiskCache::Trim() {
+        std::lock_guard<std::mutex> lg(m_cacheMutex);
+        TrimUnlocked();
+    }
+
+    void ImageDiskCache::TrimUnlocked() {
+        if (!std::filesystem::exists(s_cacheDirectory)) return;
+
+        std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+        std::uintmax_t totalSize = 0;
+        for (auto& entry : std::filesystem::directory_iterator(s_cacheDirectory)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".raw") continue;
+            totalSize += entry.file_size();
+            entries.push_back({entry.last_write_time(), entry.path()});
+        }
+        if (totalSize <= s_budget) return;
+
+        std::sort(entries.begin(), entries.end());
+        for (auto& entry : entries) {
+            if (totalSize <= s_budget) break;
+            std::error_code errorCode;
+            std::uintmax_t entrySize = std::filesystem::file_size(entry.second, errorCode);
+            if (errorCode) continue;
+            // on POSIX an entry that is still mapped stays readable after removal
+            if (std::filesystem::remove(entry.second, errorCode)) {
+                totalSize -= entrySize;
+            }
+        }
+    }
+};
\ No newline at end of file
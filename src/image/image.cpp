@@ -1,7 +1,11 @@
 #define OIIO_STATIC_BUILD
 
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/imagecache.h>
+#include <cstring>
+#include <glm/gtc/packing.hpp>
 #include "image/image.h"
+#include "image/disk_cache.h"
 
 
 namespace Raster {
@@ -9,37 +13,293 @@ namespace Raster {
         this->width = this->height = 0;
         this->channels = 0;
         this->precision = ImagePrecision::Usual;
+        this->originalWidth = this->originalHeight = 0;
+        this->mapping = nullptr;
+        this->mappingOffset = this->mappingSize = 0;
     }
 
-    std::optional<Image> ImageLoader::Load(std::string t_path) {
+    uint8_t* Image::GetData() {
+        if (mapping) return mapping->data + mappingOffset;
+        return data.data();
+    }
+
+    size_t Image::GetDataSize() {
+        if (mapping) return mappingSize;
+        return data.size();
+    }
+
+    ImageLoaderOptions::ImageLoaderOptions() {
+        this->targetResolution = std::nullopt;
+        this->part = 0;
+        this->layer = std::nullopt;
+        this->useDiskCache = false;
+    }
+
+    static auto& GetSharedImageCache() {
+        static auto s_cache = [] {
+            auto cache = OIIO::ImageCache::create(true);
+            cache->attribute("max_memory_MB", 1024.0f);
+            cache->attribute("autotile", 64);
+            cache->attribute("automip", 1);
+            return cache;
+        }();
+        return s_cache;
+    }
+
+    static std::string GetChannelLayer(const std::string& t_channel) {
+        auto dotPosition = t_channel.rfind('.');
+        if (dotPosition == std::string::npos) return "";
+        return t_channel.substr(0, dotPosition);
+    }
+
+    static int GetChannelRank(const std::string& t_channel) {
+        auto dotPosition = t_channel.rfind('.');
+        std::string suffix = dotPosition == std::string::npos ? t_channel : t_channel.substr(dotPosition + 1);
+        if (suffix == "R" || suffix == "r") return 0;
+        if (suffix == "G" || suffix == "g") return 1;
+        if (suffix == "B" || suffix == "b") return 2;
+        if (suffix == "A" || suffix == "a") return 3;
+        // X, Y and Z stand for R, G and B only inside named layers (N.X, P.Z), an unlayered Z is depth
+        // and must not push alpha out of a plain RGBA + Z render
+        if (dotPosition != std::string::npos) {
+            if (suffix == "X" || suffix == "x") return 0;
+            if (suffix == "Y" || suffix == "y") return 1;
+            if (suffix == "Z" || suffix == "z") return 2;
+        }
+        return 4;
+    }
+
+    struct ChannelSelection {
+        int begin, end;
+        // channel indices relative to begin, in the order they end up in the image
+        std::vector<int> order;
+    };
+
+    // OIIO can only read contiguous channel ranges, so the smallest range that
+    // contains the layer is read and reordered into RGBA afterwards
+    static ChannelSelection SelectChannels(const OIIO::ImageSpec& t_spec, std::optional<std::string> t_layer) {
+        ChannelSelection selection;
+        if (!t_layer.has_value() && t_spec.nchannels <= 4) {
+            selection.begin = 0;
+            selection.end = t_spec.nchannels;
+            for (int i = 0; i < t_spec.nchannels; i++) selection.order.push_back(i);
+            return selection;
+        }
+
+        std::string targetLayer = t_layer.value_or("");
+        std::vector<int> channels;
+        for (int i = 0; i < t_spec.nchannels; i++) {
+            if (i < (int) t_spec.channelnames.size() && GetChannelLayer(t_spec.channelnames[i]) == targetLayer) {
+                channels.push_back(i);
+            }
+        }
+        if (channels.empty()) {
+            for (int i = 0; i < std::min(t_spec.nchannels, 4); i++) channels.push_back(i);
+        }
+        std::stable_sort(channels.begin(), channels.end(), [&t_spec](int a, int b) {
+            if (a >= (int) t_spec.channelnames.size() || b >= (int) t_spec.channelnames.size()) return false;
+            return GetChannelRank(t_spec.channelnames[a]) < GetChannelRank(t_spec.channelnames[b]);
+        });
+        if (channels.size() > 4) channels.resize(4);
+
+        selection.begin = *std::min_element(channels.begin(), channels.end());
+        selection.end = *std::max_element(channels.begin(), channels.end()) + 1;
+        for (auto& channel : channels) selection.order.push_back(channel - selection.begin);
+        return selection;
+    }
+
+    static Image AssembleImage(const OIIO::ImageSpec& t_spec, OIIO::TypeDesc t_typeDesc, std::vector<uint8_t>& t_data, ChannelSelection& t_selection) {
+        Image result;
+        result.precision = ImagePrecision::Usual;
+        if (t_typeDesc == OIIO::TypeDesc::HALF) {
+            result.precision = ImagePrecision::Half;
+        } else if (t_typeDesc == OIIO::TypeDesc::FLOAT) {
+            result.precision = ImagePrecision::Full;
+        }
+        result.channels = (int) t_selection.order.size();
+        result.width = t_spec.width;
+        result.height = t_spec.height;
+        result.originalWidth = t_spec.width;
+        result.originalHeight = t_spec.height;
+
+        int spanChannels = t_selection.end - t_selection.begin;
+        bool identity = spanChannels == (int) t_selection.order.size();
+        for (int i = 0; identity && i < (int) t_selection.order.size(); i++) {
+            identity = t_selection.order[i] == i;
+        }
+        if (identity) {
+            result.data = std::move(t_data);
+            return result;
+        }
+
+        size_t elementSize = t_typeDesc.elementsize();
+        size_t pixelCount = (size_t) t_spec.width * t_spec.height;
+        result.data.resize(pixelCount * result.channels * elementSize);
+        for (size_t pixel = 0; pixel < pixelCount; pixel++) {
+            uint8_t* source = t_data.data() + pixel * spanChannels * elementSize;
+            uint8_t* destination = result.data.data() + pixel * result.channels * elementSize;
+            for (int channel = 0; channel < result.channels; channel++) {
+                std::memcpy(destination + channel * elementSize, source + t_selection.order[channel] * elementSize, elementSize);
+            }
+        }
+        return result;
+    }
+
+    static OIIO::TypeDesc GetTargetTypeDesc(const OIIO::ImageSpec& t_spec) {
+        OIIO::TypeDesc targetTypeDesc = OIIO::TypeDesc::UINT8;
+        if (t_spec.format.elementsize() == 2) targetTypeDesc = OIIO::TypeDesc::HALF;
+        if (t_spec.format.elementsize() == 4) targetTypeDesc = OIIO::TypeDesc::FLOAT;
+        return targetTypeDesc;
+    }
+
+    std::optional<Image> ImageLoader::Load(std::string t_path, ImageLoaderOptions t_options) {
+        if (t_options.targetResolution.has_value()) {
+            return LoadFromImageCache(t_path, t_options);
+        }
+
         auto input = OIIO::ImageInput::open(t_path);
         if (!input) {
             std::cout << OIIO::geterror() << std::endl;
             return std::nullopt;
         }
+        if (t_options.part != 0 && !input->seek_subimage(t_options.part, 0)) {
+            std::cout << "image '" << t_path << "' has no part " << t_options.part << std::endl;
+            input->close();
+            return std::nullopt;
+        }
         const OIIO::ImageSpec& spec = input->spec();
 
-        OIIO::TypeDesc targetTypeDesc = OIIO::TypeDesc::UINT8;
-        if (spec.format.elementsize() == 2) targetTypeDesc = OIIO::TypeDesc::HALF;
-        if (spec.format.elementsize() == 4) targetTypeDesc = OIIO::TypeDesc::FLOAT;
-        std::vector<uint8_t> data(spec.width * spec.height * spec.nchannels * targetTypeDesc.elementsize());
-        input->read_image(0, 0, 0, spec.nchannels, targetTypeDesc, data.data());
+        OIIO::TypeDesc targetTypeDesc = GetTargetTypeDesc(spec);
+        auto selection = SelectChannels(spec, t_options.layer);
+        std::vector<uint8_t> data((size_t) spec.width * spec.height * (selection.end - selection.begin) * targetTypeDesc.elementsize());
+        input->read_image(t_options.part, 0, selection.begin, selection.end, targetTypeDesc, data.data());
+
+        Image result = AssembleImage(spec, targetTypeDesc, data, selection);
+
+        input->close();
+        return result;
+    }
+
+    std::optional<Image> ImageLoader::LoadFromImageCache(std::string t_path, ImageLoaderOptions t_options) {
+        auto& cache = GetSharedImageCache();
+        OIIO::ustring filename(t_path);
+        auto targetResolution = t_options.targetResolution.value();
+
+        const OIIO::ImageSpec* originalSpec = cache->imagespec(filename, t_options.part, 0);
+        if (!originalSpec) {
+            std::cout << cache->geterror() << std::endl;
+            return std::nullopt;
+        }
+
+        int mipLevels = 1;
+        cache->get_image_info(filename, t_options.part, 0, OIIO::ustring("miplevels"), OIIO::TypeDesc::INT, &mipLevels);
+
+        // walk down the mip chain while the next level still covers the target resolution
+        int targetMipLevel = 0;
+        for (int level = 1; level < mipLevels; level++) {
+            const OIIO::ImageSpec* levelSpec = cache->imagespec(filename, t_options.part, level);
+            if (!levelSpec || levelSpec->width < targetResolution.x || levelSpec->height < targetResolution.y) break;
+            targetMipLevel = level;
+        }
+
+        const OIIO::ImageSpec& spec = *cache->imagespec(filename, t_options.part, targetMipLevel);
+
+        OIIO::TypeDesc targetTypeDesc = GetTargetTypeDesc(spec);
+        auto selection = SelectChannels(spec, t_options.layer);
+        std::vector<uint8_t> data((size_t) spec.width * spec.height * (selection.end - selection.begin) * targetTypeDesc.elementsize());
+        bool success = cache->get_pixels(filename, t_options.part, targetMipLevel,
+            spec.x, spec.x + spec.width, spec.y, spec.y + spec.height, spec.z, spec.z + std::max(spec.depth, 1),
+            selection.begin, selection.end, targetTypeDesc, data.data());
+        if (!success) {
+            std::cout << cache->geterror() << std::endl;
+            return std::nullopt;
+        }
+
+        Image result = AssembleImage(spec, targetTypeDesc, data, selection);
+        result.originalWidth = originalSpec->width;
+        result.originalHeight = originalSpec->height;
+
+        return result;
+    }
+
+    std::vector<ImagePartInfo> ImageLoader::GetParts(std::string t_path) {
+        std::vector<ImagePartInfo> result;
+        auto input = OIIO::ImageInput::open(t_path);
+        if (!input) {
+            std::cout << OIIO::geterror() << std::endl;
+            return result;
+        }
+
+        int partIndex = 0;
+        while (input->seek_subimage(partIndex, 0)) {
+            const OIIO::ImageSpec& spec = input->spec();
+            ImagePartInfo info;
+            info.index = partIndex;
+            info.name = spec.get_string_attribute("name", FormatString("#%i", partIndex));
+            info.channels = spec.nchannels;
+            for (auto& channelName : spec.channelnames) {
+                std::string layer = GetChannelLayer(channelName);
+                if (std::find(info.layers.begin(), info.layers.end(), layer) == info.layers.end()) {
+                    info.layers.push_back(layer);
+                }
+            }
+            result.push_back(info);
+            partIndex++;
+        }
+
+        input->close();
+        return result;
+    }
+
+    Image ImageLoader::GenerateThumbnail(Image& t_image, uint32_t t_maxSize) {
+        float scale = std::max((float) std::max(t_image.width, t_image.height) / (float) t_maxSize, 1.0f);
 
         Image result;
         result.precision = ImagePrecision::Usual;
-        if (targetTypeDesc == OIIO::TypeDesc::UINT8) {
-            result.precision = ImagePrecision::Usual;
-        } else if (targetTypeDesc == OIIO::TypeDesc::HALF) {
-            result.precision = ImagePrecision::Half;
-        } else if (targetTypeDesc == OIIO::TypeDesc::FLOAT) {
-            result.precision = ImagePrecision::Full;
+        result.channels = t_image.channels;
+        result.width = std::max((uint32_t) std::round(t_image.width / scale), (uint32_t) 1);
+        result.height = std::max((uint32_t) std::round(t_image.height / scale), (uint32_t) 1);
+        result.originalWidth = t_image.originalWidth;
+        result.originalHeight = t_image.originalHeight;
+        result.data.resize((size_t) result.width * result.height * result.channels);
+
+        uint8_t* source = t_image.GetData();
+        auto fetch = [&t_image, source](size_t t_index) {
+            if (t_image.precision == ImagePrecision::Half) return glm::unpackHalf1x16(((uint16_t*) source)[t_index]);
+            if (t_image.precision == ImagePrecision::Full) return ((float*) source)[t_index];
+            return source[t_index] / 255.0f;
+        };
+        // half and full precision images are usually stored in linear space
+        bool linearSource = t_image.precision != ImagePrecision::Usual;
+
+        std::vector<float> accumulator(result.channels);
+        for (uint32_t y = 0; y < result.height; y++) {
+            uint32_t sourceY0 = std::min((uint32_t) (y * scale), t_image.height - 1);
+            uint32_t sourceY1 = std::max(std::min((uint32_t) ((y + 1) * scale), t_image.height), sourceY0 + 1);
+            for (uint32_t x = 0; x < result.width; x++) {
+                uint32_t sourceX0 = std::min((uint32_t) (x * scale), t_image.width - 1);
+                uint32_t sourceX1 = std::max(std::min((uint32_t) ((x + 1) * scale), t_image.width), sourceX0 + 1);
+
+                std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+                for (uint32_t sourceY = sourceY0; sourceY < sourceY1; sourceY++) {
+                    for (uint32_t sourceX = sourceX0; sourceX < sourceX1; sourceX++) {
+                        size_t sourceIndex = ((size_t) sourceY * t_image.width + sourceX) * t_image.channels;
+                        for (int channel = 0; channel < result.channels; channel++) {
+                            accumulator[channel] += fetch(sourceIndex + channel);
+                        }
+                    }
+                }
+
+                float area = (float) ((sourceX1 - sourceX0) * (sourceY1 - sourceY0));
+                size_t destinationIndex = ((size_t) y * result.width + x) * result.channels;
+                for (int channel = 0; channel < result.channels; channel++) {
+                    float value = accumulator[channel] / area;
+                    if (linearSource && channel < 3) value = std::pow(std::max(value, 0.0f), 1.0f / 2.2f);
+                    result.data[destinationIndex + channel] = (uint8_t) (std::clamp(value, 0.0f, 1.0f) * 255.0f);
+                }
+            }
         }
-        result.channels = spec.nchannels;
-        result.width = spec.width;
-        result.height = spec.height;
-        result.data = data;
 
-        input->close();
         return result;
     }
 
@@ -75,20 +335,85 @@ namespace Raster {
         return result;
     }
 
+    std::mutex ImageDecodePool::m_queueMutex;
+    std::condition_variable ImageDecodePool::m_queueCondition;
+    std::deque<std::packaged_task<ImageDecodeResult()>> ImageDecodePool::m_queue;
+    std::vector<std::thread> ImageDecodePool::m_workers;
+    std::atomic<int> ImageDecodePool::m_pendingCount = 0;
+
+    std::future<ImageDecodeResult> ImageDecodePool::Decode(std::string t_path, ImageLoaderOptions t_options) {
+        EnsureWorkers();
+        std::packaged_task<ImageDecodeResult()> task([t_path, t_options] {
+            std::optional<std::string> cacheKey;
+            if (t_options.useDiskCache) {
+                cacheKey = ImageDiskCache::GetKey(t_path, t_options);
+                if (cacheKey.has_value()) {
+                    auto cachedCandidate = ImageDiskCache::Load(cacheKey.value());
+                    if (cachedCandidate.has_value()) {
+                        return ImageDecodeResult(std::make_shared<Image>(std::move(cachedCandidate.value())));
+                    }
+                }
+            }
+
+            auto decodeStart = std::chrono::steady_clock::now();
+            auto candidate = ImageLoader::Load(t_path, t_options);
+            if (!candidate.has_value()) return ImageDecodeResult(std::nullopt);
+
+            // only decodes that are noticeably slower than reading raw pixels are worth caching
+            auto decodeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - decodeStart);
+            if (cacheKey.has_value() && decodeTime.count() >= 50) {
+                ImageDiskCache::Store(cacheKey.value(), candidate.value());
+            }
+            return ImageDecodeResult(std::make_shared<Image>(std::move(candidate.value())));
+        });
+        auto future = task.get_future();
+        {
+            std::lock_guard<std::mutex> lg(m_queueMutex);
+            m_queue.push_back(std::move(task));
+            m_pendingCount++;
+        }
+        m_queueCondition.notify_one();
+        return future;
+    }
+
+    int ImageDecodePool::GetPendingCount() {
+        return m_pendingCount;
+    }
+
+    void ImageDecodePool::EnsureWorkers() {
+        std::lock_guard<std::mutex> lg(m_queueMutex);
+        if (!m_workers.empty()) return;
+        int workersCount = std::max((int) std::thread::hardware_concurrency() / 2, 2);
+        for (int i = 0; i < workersCount; i++) {
+            m_workers.push_back(std::thread(ImageDecodePool::WorkerLogic));
+            m_workers.back().detach();
+        }
+    }
+
+    void ImageDecodePool::WorkerLogic() {
+        while (true) {
+            std::packaged_task<ImageDecodeResult()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_queueCondition.wait(lock, [] { return !m_queue.empty(); });
+                task = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            task();
+            m_pendingCount--;
+        }
+    }
+
     AsyncImageLoader::AsyncImageLoader() {
         this->m_initialized = false;
     }
 
-    AsyncImageLoader::AsyncImageLoader(std::string t_path) {
-        this->m_future = std::async(std::launch::async, [t_path] {
-            auto candidate = ImageLoader::Load(t_path);
-            if (!candidate.has_value()) return std::optional<std::shared_ptr<Image>>(std::nullopt);
-            return std::optional(std::make_shared<Image>(candidate.value()));
-        });
+    AsyncImageLoader::AsyncImageLoader(std::string t_path, ImageLoaderOptions t_options) {
+        this->m_future = ImageDecodePool::Decode(t_path, t_options);
         this->m_initialized = true;
     }
 
-    std::optional<std::shared_ptr<Image>> AsyncImageLoader::Get() {
+    ImageDecodeResult AsyncImageLoader::Get() {
         return m_future.get();
     }
 
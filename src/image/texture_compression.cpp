@@ -0,0 +1,379 @@
+#include "image/texture_compression.h"
+#include <cstring>
+
+#define RASTER_COMPRESSED_IMAGE_VERSION 1
+
+namespace Raster {
+
+    // ETC1 intensity modifiers, indexed by table codeword and by (msb << 1) | lsb of the pixel index
+    static const int s_etcModifiers[8][4] = {
+        {2, 8, -2, -8},
+        {5, 17, -5, -17},
+        {9, 29, -9, -29},
+        {13, 42, -13, -42},
+        {18, 60, -18, -60},
+        {24, 80, -24, -80},
+        {33, 106, -33, -106},
+        {47, 183, -47, -183}
+    };
+
+    // EAC modifiers, scaled by the multiplier of the block
+    static const int s_eacModifiers[16][8] = {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+
+    // color errors are weighted by luma, green mistakes are the most visible ones
+    static const int64_t s_channelWeights[3] = {299, 587, 114};
+
+    // pixels of a 4x4 block indexed by x * 4 + y, the order pixel indices are stored in
+    struct CompressionBlock {
+        int rgba[16][4];
+    };
+
+    // pixels of both sub-blocks for the two flip modes, side by side halves and stacked halves
+    static const int s_subblockPixels[2][2][8] = {
+        {{0, 1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}},
+        {{0, 1, 4, 5, 8, 9, 12, 13}, {2, 3, 6, 7, 10, 11, 14, 15}}
+    };
+
+    struct SubblockEncoding {
+        glm::ivec3 color;
+        int table;
+        uint8_t indices[8];
+        int64_t error;
+    };
+
+    struct ColorEncoding {
+        bool differential;
+        int flip;
+        SubblockEncoding subblocks[2];
+        int64_t error;
+    };
+
+    static int ExpandColor(int t_value, int t_bits) {
+        return t_bits == 4 ? t_value * 17 : (t_value << 3) | (t_value >> 2);
+    }
+
+    // best table and pixel indices for a base color given in t_bits per channel
+    static SubblockEncoding EncodeSubblock(CompressionBlock& t_block, const int* t_pixels, glm::ivec3 t_color, int t_bits) {
+        glm::ivec3 base = glm::ivec3(ExpandColor(t_color.r, t_bits), ExpandColor(t_color.g, t_bits), ExpandColor(t_color.b, t_bits));
+
+        SubblockEncoding best;
+        best.color = t_color;
+        best.error = INT64_MAX;
+        for (int table = 0; table < 8; table++) {
+            SubblockEncoding candidate;
+            candidate.color = t_color;
+            candidate.table = table;
+            candidate.error = 0;
+            for (int i = 0; i < 8; i++) {
+                auto& pixel = t_block.rgba[t_pixels[i]];
+                int64_t bestPixelError = INT64_MAX;
+                for (int index = 0; index < 4; index++) {
+                    int64_t pixelError = 0;
+                    for (int channel = 0; channel < 3; channel++) {
+                        int64_t difference = std::clamp(base[channel] + s_etcModifiers[table][index], 0, 255) - pixel[channel];
+                        pixelError += difference * difference * s_channelWeights[channel];
+                    }
+                    if (pixelError < bestPixelError) {
+                        bestPixelError = pixelError;
+                        candidate.indices[i] = (uint8_t) index;
+                    }
+                }
+                candidate.error += bestPixelError;
+                if (candidate.error >= best.error) break;
+            }
+            if (candidate.error < best.error) best = candidate;
+        }
+        return best;
+    }
+
+    // tries the quantized average color and its neighbours allowed by the quality, within [t_min, t_max]
+    static SubblockEncoding SearchSubblock(CompressionBlock& t_block, const int* t_pixels, glm::vec3 t_average, int t_bits, glm::ivec3 t_min, glm::ivec3 t_max, TextureCompressionQuality t_quality) {
+        int levels = (1 << t_bits) - 1;
+        glm::ivec3 center = glm::clamp(glm::ivec3(glm::round(t_average * (float) levels / 255.0f)), t_min, t_max);
+
+        std::vector<glm::ivec3> offsets = {glm::ivec3(0)};
+        if (t_quality == TextureCompressionQuality::Balanced) {
+            offsets.insert(offsets.end(), {
+                glm::ivec3(1), glm::ivec3(-1),
+                glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0),
+                glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0),
+                glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)
+            });
+        } else if (t_quality == TextureCompressionQuality::High) {
+            offsets.clear();
+            for (int r = -1; r <= 1; r++) {
+                for (int g = -1; g <= 1; g++) {
+                    for (int b = -1; b <= 1; b++) {
+                        offsets.push_back(glm::ivec3(r, g, b));
+                    }
+                }
+            }
+        }
+
+        SubblockEncoding best;
+        best.error = INT64_MAX;
+        for (auto& offset : offsets) {
+            glm::ivec3 color = center + offset;
+            if (glm::any(glm::lessThan(color, t_min)) || glm::any(glm::greaterThan(color, t_max))) continue;
+            auto candidate = EncodeSubblock(t_block, t_pixels, color, t_bits);
+            if (candidate.error < best.error) best = candidate;
+        }
+        return best;
+    }
+
+    static ColorEncoding EncodeColor(CompressionBlock& t_block, TextureCompressionQuality t_quality) {
+        ColorEncoding best;
+        best.error = INT64_MAX;
+        for (int flip = 0; flip < 2; flip++) {
+            glm::vec3 averages[2];
+            for (int subblock = 0; subblock < 2; subblock++) {
+                averages[subblock] = glm::vec3(0);
+                for (int i = 0; i < 8; i++) {
+                    auto& pixel = t_block.rgba[s_subblockPixels[flip][subblock][i]];
+                    averages[subblock] += glm::vec3(pixel[0], pixel[1], pixel[2]) / 8.0f;
+                }
+            }
+
+            // individual mode, two independent 4-bit colors
+            ColorEncoding individual;
+            individual.differential = false;
+            individual.flip = flip;
+            for (int subblock = 0; subblock < 2; subblock++) {
+                individual.subblocks[subblock] = SearchSubblock(t_block, s_subblockPixels[flip][subblock], averages[subblock], 4, glm::ivec3(0), glm::ivec3(15), t_quality);
+            }
+            individual.error = individual.subblocks[0].error + individual.subblocks[1].error;
+            if (individual.error < best.error) best = individual;
+
+            // differential mode, a 5-bit color and a second one at most 4 below or 3 above it.
+            // Leaving that range would turn the block into one of the ETC2 T, H or planar modes
+            ColorEncoding differential;
+            differential.differential = true;
+            differential.flip = flip;
+            differential.subblocks[0] = SearchSubblock(t_block, s_subblockPixels[flip][0], averages[0], 5, glm::ivec3(0), glm::ivec3(31), t_quality);
+            glm::ivec3 first = differential.subblocks[0].color;
+            differential.subblocks[1] = SearchSubblock(t_block, s_subblockPixels[flip][1], averages[1], 5, glm::max(first - 4, glm::ivec3(0)), glm::min(first + 3, glm::ivec3(31)), t_quality);
+            differential.error = differential.subblocks[0].error + differential.subblocks[1].error;
+            if (differential.error < best.error) best = differential;
+        }
+        return best;
+    }
+
+    static uint64_t PackColor(ColorEncoding& t_encoding) {
+        auto& first = t_encoding.subblocks[0];
+        auto& second = t_encoding.subblocks[1];
+        uint64_t bits = 0;
+        if (t_encoding.differential) {
+            glm::ivec3 delta = second.color - first.color;
+            bits |= (uint64_t) first.color.r << 59 | (uint64_t) (delta.r & 7) << 56;
+            bits |= (uint64_t) first.color.g << 51 | (uint64_t) (delta.g & 7) << 48;
+            bits |= (uint64_t) first.color.b << 43 | (uint64_t) (delta.b & 7) << 40;
+            bits |= (uint64_t) 1 << 33;
+        } else {
+            bits |= (uint64_t) first.color.r << 60 | (uint64_t) second.color.r << 56;
+            bits |= (uint64_t) first.color.g << 52 | (uint64_t) second.color.g << 48;
+            bits |= (uint64_t) first.color.b << 44 | (uint64_t) second.color.b << 40;
+        }
+        bits |= (uint64_t) first.table << 37 | (uint64_t) second.table << 34;
+        bits |= (uint64_t) t_encoding.flip << 32;
+
+        for (int subblock = 0; subblock < 2; subblock++) {
+            for (int i = 0; i < 8; i++) {
+                int pixel = s_subblockPixels[t_encoding.flip][subblock][i];
+                int index = t_encoding.subblocks[subblock].indices[i];
+                bits |= (uint64_t) (index >> 1) << (16 + pixel);
+                bits |= (uint64_t) (index & 1) << pixel;
+            }
+        }
+        return bits;
+    }
+
+    static uint64_t EncodeAlpha(CompressionBlock& t_block, TextureCompressionQuality t_quality) {
+        int minimum = 255, maximum = 0;
+        for (auto& pixel : t_block.rgba) {
+            minimum = std::min(minimum, pixel[3]);
+            maximum = std::max(maximum, pixel[3]);
+        }
+
+        int64_t bestError = INT64_MAX;
+        uint64_t bestBits = 0;
+        int searchRadius = t_quality == TextureCompressionQuality::Fast ? 0 : 1;
+        for (int table = 0; table < 16; table++) {
+            auto& modifiers = s_eacModifiers[table];
+            int span = modifiers[7] - modifiers[3];
+            int fittedMultiplier = std::clamp((int) std::round((float) (maximum - minimum) / (float) span), 1, 15);
+            for (int multiplierOffset = -searchRadius; multiplierOffset <= searchRadius; multiplierOffset++) {
+                int multiplier = fittedMultiplier + multiplierOffset;
+                if (multiplier < 1 || multiplier > 15) continue;
+                // the base sits where the table maps the middle of the alpha range
+                int fittedBase = (int) std::round((minimum + maximum) / 2.0f - (modifiers[7] + modifiers[3]) * multiplier / 2.0f);
+                for (int baseOffset = -searchRadius; baseOffset <= searchRadius; baseOffset++) {
+                    int base = std::clamp(fittedBase + baseOffset, 0, 255);
+                    uint64_t bits = (uint64_t) base << 56 | (uint64_t) multiplier << 52 | (uint64_t) table << 48;
+                    int64_t error = 0;
+                    for (int pixel = 0; pixel < 16 && error < bestError; pixel++) {
+                        int64_t bestPixelError = INT64_MAX;
+                        int bestIndex = 0;
+                        for (int index = 0; index < 8; index++) {
+                            int64_t difference = std::clamp(base + modifiers[index] * multiplier, 0, 255) - t_block.rgba[pixel][3];
+                            if (difference * difference < bestPixelError) {
+                                bestPixelError = difference * difference;
+                                bestIndex = index;
+                            }
+                        }
+                        error += bestPixelError;
+                        bits |= (uint64_t) bestIndex << (45 - 3 * pixel);
+                    }
+                    if (error < bestError) {
+                        bestError = error;
+                        bestBits = bits;
+                    }
+                }
+            }
+        }
+        return bestBits;
+    }
+
+    static void WriteBigEndian(uint8_t* t_destination, uint64_t t_bits) {
+        for (int i = 0; i < 8; i++) {
+            t_destination[i] = (uint8_t) (t_bits >> (56 - i * 8));
+        }
+    }
+
+    bool TextureCompression::IsCompressible(Image& t_image) {
+        return t_image.precision == ImagePrecision::Usual && (t_image.channels == 3 || t_image.channels == 4) && t_image.width > 0 && t_image.height > 0;
+    }
+
+    std::optional<CompressedImage> TextureCompression::Compress(Image& t_image, TextureCompressionQuality t_quality) {
+        if (!IsCompressible(t_image)) return std::nullopt;
+
+        CompressedImage result;
+        result.width = t_image.width;
+        result.height = t_image.height;
+        result.originalWidth = t_image.originalWidth;
+        result.originalHeight = t_image.originalHeight;
+        result.channels = t_image.channels;
+
+        uint32_t blocksX = (t_image.width + 3) / 4;
+        uint32_t blocksY = (t_image.height + 3) / 4;
+        size_t blockSize = result.channels == 4 ? 16 : 8;
+        result.data.resize((size_t) blocksX * blocksY * blockSize);
+
+        uint8_t* source = t_image.GetData();
+        auto encodeRow = [&](uint32_t t_blockY) {
+            CompressionBlock block;
+            for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+                // blocks crossing the image border repeat its last row and column
+                for (int x = 0; x < 4; x++) {
+                    for (int y = 0; y < 4; y++) {
+                        uint32_t sourceX = std::min(blockX * 4 + x, t_image.width - 1);
+                        uint32_t sourceY = std::min(t_blockY * 4 + y, t_image.height - 1);
+                        uint8_t* pixel = source + ((size_t) sourceY * t_image.width + sourceX) * t_image.channels;
+                        auto& destination = block.rgba[x * 4 + y];
+                        for (int channel = 0; channel < 4; channel++) {
+                            destination[channel] = channel < t_image.channels ? pixel[channel] : 255;
+                        }
+                    }
+                }
+
+                uint8_t* destination = result.data.data() + ((size_t) t_blockY * blocksX + blockX) * blockSize;
+                if (result.channels == 4) {
+                    WriteBigEndian(destination, EncodeAlpha(block, t_quality));
+                    destination += 8;
+                }
+                auto colorEncoding = EncodeColor(block, t_quality);
+                WriteBigEndian(destination, PackColor(colorEncoding));
+            }
+        };
+
+        int workersCount = std::max((int) std::thread::hardware_concurrency() / 2, 2);
+        std::vector<std::thread> workers;
+        for (int worker = 0; worker < workersCount; worker++) {
+            workers.push_back(std::thread([&, worker]() {
+                for (uint32_t blockY = worker; blockY < blocksY; blockY += workersCount) {
+                    encodeRow(blockY);
+                }
+            }));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return result;
+    }
+
+    struct CompressedImageHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t width, height;
+        uint32_t originalWidth, originalHeight;
+        int32_t channels;
+        uint32_t padding;
+        uint64_t dataSize;
+        uint8_t reserved[24];
+    };
+
+    static_assert(sizeof(CompressedImageHeader) == 64);
+
+    std::optional<CompressedImage> TextureCompression::Read(std::string t_path) {
+        std::ifstream stream(t_path, std::ios::binary);
+        if (!stream.is_open()) return std::nullopt;
+
+        CompressedImageHeader header;
+        if (!stream.read((char*) &header, sizeof(header))) return std::nullopt;
+        if (std::memcmp(header.magic, "RETC", 4) != 0 || header.version != RASTER_COMPRESSED_IMAGE_VERSION) return std::nullopt;
+
+        CompressedImage result;
+        result.width = header.width;
+        result.height = header.height;
+        result.originalWidth = header.originalWidth;
+        result.originalHeight = header.originalHeight;
+        result.channels = header.channels;
+        size_t blockSize = result.channels == 4 ? 16 : 8;
+        if (header.dataSize != (uint64_t) ((result.width + 3) / 4) * ((result.height + 3) / 4) * blockSize) return std::nullopt;
+
+        result.data.resize(header.dataSize);
+        if (!stream.read((char*) result.data.data(), header.dataSize)) return std::nullopt;
+        return result;
+    }
+
+    bool TextureCompression::Write(std::string t_path, CompressedImage& t_image) {
+        CompressedImageHeader header = {};
+        std::memcpy(header.magic, "RETC", 4);
+        header.version = RASTER_COMPRESSED_IMAGE_VERSION;
+        header.width = t_image.width;
+        header.height = t_image.height;
+        header.originalWidth = t_image.originalWidth;
+        header.originalHeight = t_image.originalHeight;
+        header.channels = t_image.channels;
+        header.dataSize = t_image.data.size();
+
+        // written under a temporary name first, so readers never see a partial file
+        std::string temporaryPath = t_path + ".tmp";
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary);
+            if (!stream.is_open()) return false;
+            stream.write((const char*) &header, sizeof(header));
+            stream.write((const char*) t_image.data.data(), t_image.data.size());
+            if (!stream.good()) return false;
+        }
+        std::error_code errorCode;
+        std::filesystem::rename(temporaryPath, t_path, errorCode);
+        return !errorCode;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,121 @@
+#define OIIO_STATIC_BUILD
+
+#include <OpenImageIO/imageio.h>
+#include <cstring>
+#include "image/tiled_image_writer.h"
+
+namespace Raster {
+    struct TiledImageWriterState {
+        std::unique_ptr<OIIO::ImageOutput> output;
+        uint32_t width, height;
+        uint32_t tileSize;
+        bool nativeTiles;
+        // format of the pixels passed in and the size of one of them
+        OIIO::TypeDesc pixelType;
+        size_t pixelSize;
+
+        // scanline fallback only, holds the row of tiles that is currently being assembled
+        std::vector<uint8_t> strip;
+        uint32_t stripY;
+        uint32_t stripRows;
+    };
+
+    TiledImageWriter::TiledImageWriter() {
+        this->m_state = nullptr;
+    }
+
+    bool TiledImageWriter::IsHighPrecisionFormat(std::string t_path) {
+        return LowerCase(std::filesystem::path(t_path).extension().string()) == ".exr";
+    }
+
+    bool TiledImageWriter::Open(std::string t_path, uint32_t t_width, uint32_t t_height, uint32_t t_tileSize) {
+        Close();
+
+        auto output = OIIO::ImageOutput::create(t_path);
+        if (!output) {
+            std::cout << OIIO::geterror() << std::endl;
+            return false;
+        }
+
+        auto state = std::make_shared<TiledImageWriterState>();
+        state->width = t_width;
+        state->height = t_height;
+        state->tileSize = t_tileSize;
+        state->nativeTiles = output->supports("tiles");
+        state->stripY = 0;
+        state->stripRows = 0;
+
+        bool highPrecision = IsHighPrecisionFormat(t_path);
+        state->pixelType = highPrecision ? OIIO::TypeDesc::FLOAT : OIIO::TypeDesc::UINT8;
+        state->pixelSize = highPrecision ? 4 * sizeof(float) : 4;
+
+        // floats are stored as half, the precision OpenEXR deliverables are usually expected in
+        OIIO::ImageSpec spec(t_width, t_height, 4, highPrecision ? OIIO::TypeDesc::HALF : OIIO::TypeDesc::UINT8);
+        if (state->nativeTiles) {
+            spec.tile_width = t_tileSize;
+            spec.tile_height = t_tileSize;
+        }
+        if (!output->open(t_path, spec)) {
+            std::cout << output->geterror() << std::endl;
+            return false;
+        }
+
+        state->output = std::move(output);
+        this->m_state = state;
+        return true;
+    }
+
+    bool TiledImageWriter::WriteTile(uint32_t t_x, uint32_t t_y, Image& t_tile) {
+        if (!m_state) return false;
+        auto& state = *m_state;
+        size_t pixelSize = state.pixelSize;
+        size_t rowSize = (size_t) t_tile.width * pixelSize;
+
+        if (state.nativeTiles) {
+            // edge tiles are padded, pixels outside of the image are ignored by the writer
+            uint8_t* data = t_tile.GetData();
+            std::vector<uint8_t> padded;
+            if (t_tile.width != state.tileSize || t_tile.height != state.tileSize) {
+                padded.resize((size_t) state.tileSize * state.tileSize * pixelSize);
+                for (uint32_t y = 0; y < t_tile.height; y++) {
+                    std::memcpy(padded.data() + (size_t) y * state.tileSize * pixelSize, t_tile.GetData() + y * rowSize, rowSize);
+                }
+                data = padded.data();
+            }
+            if (!state.output->write_tile(t_x, t_y, 0, state.pixelType, data)) {
+                std::cout << state.output->geterror() << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        if (state.strip.empty() || t_y != state.stripY) {
+            state.strip.assign((size_t) state.width * state.tileSize * pixelSize, 0);
+            state.stripY = t_y;
+        }
+        state.stripRows = t_tile.height;
+        for (uint32_t y = 0; y < t_tile.height; y++) {
+            std::memcpy(state.strip.data() + ((size_t) y * state.width + t_x) * pixelSize, t_tile.GetData() + y * rowSize, rowSize);
+        }
+
+        // the last tile of the row completes the strip
+        if (t_x + t_tile.width >= state.width) {
+            if (!state.output->write_scanlines(state.stripY, state.stripY + state.stripRows, 0, state.pixelType, state.strip.data())) {
+                std::cout << state.output->geterror() << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool TiledImageWriter::Close() {
+        if (!m_state) return true;
+        bool result = m_state->output->close();
+        this->m_state = nullptr;
+        return result;
+    }
+
+    bool TiledImageWriter::IsOpen() {
+        return m_state != nullptr;
+    }
+};
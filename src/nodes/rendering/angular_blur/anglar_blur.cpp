@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> AngularBlur::s_pipeline;
+    PendingPipeline AngularBlur::s_pipeline;
 
     AngularBlur::AngularBlur() {
         NodeBase::Initialize();
@@ -15,20 +15,14 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "angular_blur/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "angular_blur/shader")
             );
         }
     }
 
-    AngularBlur::~AngularBlur() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
-        }
-    }
-
     AbstractPinMap AngularBlur::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
 
@@ -37,14 +31,15 @@ namespace Raster {
         auto centerCandidate = GetAttribute<glm::vec2>("Center");
         auto samplesCandidate = GetAttribute<int>("Samples");
         
-        if (s_pipeline.has_value() && baseCandidate.has_value() && angleCandidate.has_value() && centerCandidate.has_value() && samplesCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && angleCandidate.has_value() && centerCandidate.has_value() && samplesCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto angle = glm::radians(angleCandidate.value());
             auto& center = centerCandidate.value();
             auto samples = (float) samplesCandidate.value();    
 
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
 
             GPU::BindFramebuffer(m_framebuffer);
             GPU::BindPipeline(pipeline);
@@ -59,6 +54,7 @@ namespace Raster {
             
             GPU::DrawArrays(3);
 
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
 
@@ -4,12 +4,13 @@
 
 #include "compositor/compositor.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 
 namespace Raster {
     struct AngularBlur : public NodeBase {
         AngularBlur();
-        ~AngularBlur();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -25,6 +26,6 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> BoxBlur::s_pipeline;
+    PendingPipeline BoxBlur::s_pipeline;
 
     BoxBlur::BoxBlur() {
         NodeBase::Initialize();
@@ -10,54 +10,61 @@ namespace Raster {
         SetupAttribute("Base", Framebuffer());
         SetupAttribute("Intensity", glm::vec2(0.5f));
         SetupAttribute("Samples", 50);
+        SetupAttribute("Gaussian", false);
 
         AddInputPin("Base");
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "box_blur/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "separable_blur/shader")
             );
         }
     }
 
-    BoxBlur::~BoxBlur() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
-        }
-    }
-
     AbstractPinMap BoxBlur::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
 
         auto baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicAttribute("Base"));
         auto intensityCandidate = GetAttribute<glm::vec2>("Intensity");
         auto samplesCandidate = GetAttribute<int>("Samples");
+        auto gaussianCandidate = GetAttribute<bool>("Gaussian");
         
-        if (s_pipeline.has_value() && baseCandidate.has_value() && intensityCandidate.has_value() && samplesCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && intensityCandidate.has_value() && samplesCandidate.has_value() && gaussianCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto& intensity = intensityCandidate.value();
-            auto samples = (float) samplesCandidate.value();    
+            auto& samples = samplesCandidate.value();
+            auto shape = gaussianCandidate.value() ? KernelShape::Gaussian : KernelShape::Box;
 
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
 
             intensity *= 0.1f;
-            intensity *= glm::vec2(m_framebuffer.width, m_framebuffer.height);
+            intensity *= Compositor::GetOutputResolution();
+            Compositor::ReportSamplingRadius(intensity * 0.5f);
+
+            // every output pixel samples at most half of the box away from itself
+            glm::vec2 extent = glm::abs(intensity) * 0.5f;
+            auto bounds = ContentBounds::Expand(base.bounds, glm::ivec2(glm::ceil(extent)) + 1, m_framebuffer);
+            RenderTargetPool::ClearTarget(m_framebuffer);
 
-            GPU::BindFramebuffer(m_framebuffer);
-            GPU::BindPipeline(pipeline);
-            GPU::ClearFramebuffer(0, 0, 0, 0);
+            // rows are filtered into an intermediate target first, then its columns into the output
+            auto horizontalTaps = SeparableKernel::Generate(shape, intensity.x, samples);
+            auto verticalTaps = SeparableKernel::Generate(shape, intensity.y, samples);
 
-            GPU::BindTextureToShader(pipeline.fragment, "uTexture", base.attachments.at(0), 0);
-            GPU::SetShaderUniform(pipeline.fragment, "uBoxBlurIntensity", intensity);
-            GPU::SetShaderUniform(pipeline.fragment, "uSamples", samples);
+            auto temporalFramebuffer = RenderTargetPool::Acquire();
+            auto horizontalBounds = ContentBounds::Expand(base.bounds, glm::ivec2((int) glm::ceil(extent.x) + 1, 0), temporalFramebuffer);
+            RenderTargetPool::ClearTarget(temporalFramebuffer);
+            SeparableKernel::Apply(pipeline, base.attachments.at(0), temporalFramebuffer, glm::vec2(1, 0), horizontalTaps, horizontalBounds);
+            RenderTargetPool::SetContentBounds(temporalFramebuffer, horizontalBounds);
 
-            GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(m_framebuffer.width, m_framebuffer.height));
-            
-            GPU::DrawArrays(3);
+            SeparableKernel::Apply(pipeline, temporalFramebuffer.attachments.at(0), m_framebuffer, glm::vec2(0, 1), verticalTaps, bounds);
+            RenderTargetPool::Release(temporalFramebuffer);
 
+            RenderTargetPool::SetContentBounds(m_framebuffer, bounds);
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
 
@@ -68,6 +75,7 @@ namespace Raster {
     void BoxBlur::AbstractRenderProperties() {
         RenderAttributeProperty("Intensity");
         RenderAttributeProperty("Samples");
+        RenderAttributeProperty("Gaussian");
     }
 
     void BoxBlur::AbstractLoadSerialized(Json t_data) {
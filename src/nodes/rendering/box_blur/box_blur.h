@@ -4,12 +4,15 @@
 
 #include "compositor/compositor.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
+#include "compositor/separable_kernel.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 
 namespace Raster {
     struct BoxBlur : public NodeBase {
         BoxBlur();
-        ~BoxBlur();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -25,6 +28,7 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        // separable_blur/shader, run once per axis
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
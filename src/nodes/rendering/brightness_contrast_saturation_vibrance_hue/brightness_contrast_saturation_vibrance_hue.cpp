@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> BrightnessContrastSaturationVibranceHue::s_pipeline;
+    PendingPipeline BrightnessContrastSaturationVibranceHue::s_pipeline;
 
     BrightnessContrastSaturationVibranceHue::BrightnessContrastSaturationVibranceHue() {
         NodeBase::Initialize();
@@ -14,10 +14,10 @@ namespace Raster {
         SetupAttribute("Vibrance", 1.0f);
         SetupAttribute("Hue", 0.0f);
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "brightness_contrast_saturation_vibrance_hue/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "brightness_contrast_saturation_vibrance_hue/shader")
             );
         }
 
@@ -35,11 +35,12 @@ namespace Raster {
         auto vibranceCandidate = GetAttribute<float>("Vibrance");
         auto hueCandidate = GetAttribute<float>("Hue");
 
-        Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
-        if (s_pipeline.has_value() && inputCandidate.has_value() && brightnessCandidate.has_value() && contrastCandidate.has_value() && saturationCandidate.has_value() && vibranceCandidate.has_value() && hueCandidate.has_value()) {
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && inputCandidate.has_value() && brightnessCandidate.has_value() && contrastCandidate.has_value() && saturationCandidate.has_value() && vibranceCandidate.has_value() && hueCandidate.has_value()) {
+            m_framebuffer = RenderTargetPool::Acquire();
             auto& framebuffer = m_framebuffer;
             auto& input = inputCandidate.value();
-            auto& pipeline = s_pipeline.value();
+            auto& pipeline = pipelineCandidate.value();
             auto& brightness = brightnessCandidate.value();
             auto& contrast = contrastCandidate.value();
             auto& saturation = saturationCandidate.value();
@@ -60,6 +61,7 @@ namespace Raster {
             GPU::BindTextureToShader(pipeline.fragment, "uTexture", input, 0);
 
             GPU::DrawArrays(3);
+            RenderTargetPool::Consume(input);
 
             TryAppendAbstractPinMap(result, "Output", framebuffer); 
         }
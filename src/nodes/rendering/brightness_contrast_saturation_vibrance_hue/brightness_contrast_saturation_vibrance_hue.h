@@ -3,7 +3,9 @@
 #include "common/common.h"
 #include "compositor/managed_framebuffer.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 
 namespace Raster {
     struct BrightnessContrastSaturationVibranceHue : public NodeBase {
@@ -22,6 +24,6 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> Checkerboard::s_pipeline;
+    PendingPipeline Checkerboard::s_pipeline;
 
     Checkerboard::Checkerboard() {
         NodeBase::Initialize();
@@ -16,10 +16,10 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Framebuffer");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "checkerboard/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "checkerboard/shader")
             );
         }
     }
@@ -38,9 +38,10 @@ namespace Raster {
         auto sizeCandidate = GetAttribute<glm::vec2>("Size");
 
         auto framebuffer = m_framebuffer.Get(baseCandidate);
-        auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
 
-        if (firstColorCandidate.has_value() && secondColorCandidate.has_value() && positionCandidate.has_value() && sizeCandidate.has_value()) {
+        if (pipelineCandidate.has_value() && firstColorCandidate.has_value() && secondColorCandidate.has_value() && positionCandidate.has_value() && sizeCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& firstColor = firstColorCandidate.value();
             auto& secondColor = secondColorCandidate.value();
             auto& position = positionCandidate.value();
@@ -56,6 +57,8 @@ namespace Raster {
 
             GPU::DrawArrays(3);
 
+            RenderTargetPool::SetContentBounds(framebuffer, std::nullopt, firstColor.a >= 1.0f && secondColor.a >= 1.0f);
+
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
         }
 
@@ -2,7 +2,9 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/managed_framebuffer.h"
+#include "compositor/render_target_pool.h"
 
 namespace Raster {
     struct Checkerboard : public NodeBase {
@@ -23,6 +25,6 @@ namespace Raster {
     private:
         ManagedFramebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
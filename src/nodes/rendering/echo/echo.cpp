@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> Echo::s_echoPipeline;
+    PendingPipeline Echo::s_echoPipeline;
 
     Echo::Echo() {
         NodeBase::Initialize();
@@ -14,23 +14,14 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Framebuffer");
 
-        if (!s_echoPipeline.has_value()) {
-            s_echoPipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "echo/shader")
+        if (!s_echoPipeline.IsRequested()) {
+            s_echoPipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "echo/shader")
             );
         }
     }
 
-    Echo::~Echo() {
-        if (m_framebuffer.handle) {
-            for (auto& attachment : m_framebuffer.attachments) {
-                GPU::DestroyTexture(attachment);
-            }
-            GPU::DestroyFramebuffer(m_framebuffer);
-        }
-    }
-
     AbstractPinMap Echo::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
         auto& project = Workspace::GetProject();
@@ -38,8 +29,9 @@ namespace Raster {
         
         auto stepsCandidate = GetAttribute<int>("Steps");
         auto frameStepCandidate = GetAttribute<int>("FrameStep");
-        if (stepsCandidate.has_value() && s_echoPipeline.has_value()) {
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+        auto pipelineCandidate = s_echoPipeline.Get();
+        if (stepsCandidate.has_value() && pipelineCandidate.has_value()) {
+            m_framebuffer = RenderTargetPool::Acquire();
             GPU::BindFramebuffer(m_framebuffer);
             GPU::ClearFramebuffer(0, 0, 0, 0);
             auto steps = stepsCandidate.value();
@@ -48,7 +40,7 @@ namespace Raster {
 
             project.TimeTravel(-steps * frameStep);
 
-            auto& pipeline = s_echoPipeline.value();
+            auto& pipeline = pipelineCandidate.value();
 
             for (int i = 0; i < steps + 1; i++) {
                 auto baseCandidate = GetAttribute<Framebuffer>("Base");
@@ -63,9 +55,12 @@ namespace Raster {
                     GPU::SetShaderUniform(pipeline.fragment, "uResolution", requiredResolution);
                     GPU::SetShaderUniform(pipeline.fragment, "uOpacity", std::clamp(opacityStep * (i + 1), 0.0f, 1.0f));
                     GPU::BindTextureToShader(pipeline.fragment, "uColorTexture", base.attachments.at(0), 0);
-                    GPU::BindTextureToShader(pipeline.fragment, "uUVTexture", base.attachments.at(1), 1);
+                    if (base.attachments.size() > 1) {
+                        GPU::BindTextureToShader(pipeline.fragment, "uUVTexture", base.attachments.at(1), 1);
+                    }
 
                     GPU::DrawArrays(3);
+                    RenderTargetPool::Consume(base);
 
                     project.TimeTravel(frameStep);
                 }
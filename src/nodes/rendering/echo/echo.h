@@ -2,13 +2,14 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/compositor.h"
+#include "compositor/render_target_pool.h"
 
 namespace Raster {
     struct Echo : public NodeBase {
     public:
         Echo();
-        ~Echo();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -23,6 +24,6 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_echoPipeline;
+        static PendingPipeline s_echoPipeline;
     };
 };
\ No newline at end of file
@@ -34,10 +34,12 @@ namespace Raster {
             auto& targets = Compositor::s_targets;
             targets.push_back(CompositorTarget{
                 .colorAttachment = renderable.attachments[0],
-                .uvAttachment = renderable.attachments[1],
+                .uvAttachment = renderable.attachments.size() > 1 ? renderable.attachments[1] : Texture(),
                 .opacity = composition->GetOpacity(),
-                .blendMode = composition->blendMode,
-                .compositionID = composition->id
+                .blendModeIndex = Compositor::GetBlendModeIndex(composition),
+                .compositionID = composition->id,
+                .bounds = renderable.bounds,
+                .opaque = renderable.opaque
             });
 
             this->lastExportedType = std::type_index(typeid(Framebuffer));
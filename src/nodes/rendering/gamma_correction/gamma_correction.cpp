@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> GammaCorrection::s_pipeline;
+    PendingPipeline GammaCorrection::s_pipeline;
 
     GammaCorrection::GammaCorrection() {
         NodeBase::Initialize();
@@ -12,32 +12,27 @@ namespace Raster {
 
         this->m_framebuffer = Framebuffer();
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "gamma_correction/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "gamma_correction/shader")
             );
         }
 
         AddOutputPin("Output");
     }
 
-    GammaCorrection::~GammaCorrection() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
-        }
-    }
-
     AbstractPinMap GammaCorrection::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
         
         auto framebufferCandidate = TextureInteroperability::GetFramebuffer(GetDynamicAttribute("Base"));
         auto gammaCandidate = GetAttribute<float>("Gamma");
-        if (s_pipeline.has_value() && gammaCandidate.has_value() && framebufferCandidate.has_value()) {
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && gammaCandidate.has_value() && framebufferCandidate.has_value()) {
             auto& gamma = gammaCandidate.value();
             auto& framebuffer = framebufferCandidate.value();
-            auto& pipeline = s_pipeline.value();
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            auto& pipeline = pipelineCandidate.value();
+            m_framebuffer = RenderTargetPool::Acquire();
 
             GPU::BindPipeline(pipeline);
             GPU::BindFramebuffer(m_framebuffer);
@@ -54,6 +49,7 @@ namespace Raster {
             GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(m_framebuffer.width, m_framebuffer.height));
 
             GPU::DrawArrays(3);
+            RenderTargetPool::Consume(framebuffer);
             
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
@@ -2,13 +2,14 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/compositor.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
 
 namespace Raster {
     struct GammaCorrection : public NodeBase {
         GammaCorrection();
-        ~GammaCorrection();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -22,6 +23,6 @@ namespace Raster {
         std::optional<std::string> Footer();
 
         Framebuffer m_framebuffer;
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
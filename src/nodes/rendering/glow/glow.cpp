@@ -0,0 +1,142 @@
+#include "glow.h"
+
+namespace Raster {
+
+    PendingPipeline Glow::s_pipeline;
+
+    Glow::Glow() {
+        NodeBase::Initialize();
+
+        SetupAttribute("Base", Framebuffer());
+        SetupAttribute("Threshold", 0.8f);
+        SetupAttribute("Softness", 0.5f);
+        SetupAttribute("Radius", 0.5f);
+        SetupAttribute("Intensity", 1.0f);
+        SetupAttribute("Color", glm::vec4(1));
+
+        AddInputPin("Base");
+        AddOutputPin("Output");
+
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "glow/shader")
+            );
+        }
+    }
+
+    AbstractPinMap Glow::AbstractExecute(AbstractPinMap t_accumulator) {
+        AbstractPinMap result = {};
+
+        auto baseCandidate = TextureInteroperability::GetFramebuffer(GetDynamicAttribute("Base"));
+        auto thresholdCandidate = GetAttribute<float>("Threshold");
+        auto softnessCandidate = GetAttribute<float>("Softness");
+        auto radiusCandidate = GetAttribute<float>("Radius");
+        auto intensityCandidate = GetAttribute<float>("Intensity");
+        auto colorCandidate = GetAttribute<glm::vec4>("Color");
+
+        auto pipelineCandidate = s_pipeline.Get();
+        bool pyramidReady = PyramidBlur::IsReady();
+        if (pipelineCandidate.has_value() && pyramidReady && baseCandidate.has_value() && thresholdCandidate.has_value() && softnessCandidate.has_value() && radiusCandidate.has_value() && intensityCandidate.has_value() && colorCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
+            auto& base = baseCandidate.value();
+            auto& threshold = thresholdCandidate.value();
+            auto& softness = softnessCandidate.value();
+            auto& radius = radiusCandidate.value();
+            auto& intensity = intensityCandidate.value();
+            auto& color = colorCandidate.value();
+
+            m_framebuffer = RenderTargetPool::Acquire();
+            glm::vec2 resolution = glm::vec2(m_framebuffer.width, m_framebuffer.height);
+            // the glow is blurred anyway, so it is extracted and blurred at half of the resolution
+            glm::vec2 glowResolution = glm::max(glm::floor(resolution * 0.5f), glm::vec2(1));
+            // the radius follows the output, not the tile being rendered, and reaches that far into the neighbouring tiles
+            float glowRadius = radius * 0.1f * Compositor::GetOutputResolution().y;
+            Compositor::ReportSamplingRadius(glm::vec2(glowRadius));
+
+            auto brightFramebuffer = RenderTargetPool::Acquire(glowResolution, TexturePrecision::Usual, 1);
+            GPU::BindFramebuffer(brightFramebuffer);
+            GPU::BindPipeline(pipeline);
+            GPU::SetBlendingEnabled(false);
+
+            GPU::SetShaderUniform(pipeline.fragment, "uStage", 0);
+            GPU::SetShaderUniform(pipeline.fragment, "uResolution", glowResolution);
+            GPU::SetShaderUniform(pipeline.fragment, "uThreshold", threshold);
+            GPU::SetShaderUniform(pipeline.fragment, "uSoftness", softness);
+            GPU::BindTextureToShader(pipeline.fragment, "uTexture", base.attachments.at(0), 0);
+            GPU::DrawArrays(3);
+            GPU::SetBlendingEnabled(true);
+
+            auto glowFramebuffer = RenderTargetPool::Acquire(glowResolution, TexturePrecision::Usual, 1);
+            PyramidBlur::Blur(brightFramebuffer.attachments.at(0), glowFramebuffer, glowRadius * glowResolution.y / resolution.y);
+            RenderTargetPool::Release(brightFramebuffer);
+
+            RenderTargetPool::ClearTarget(m_framebuffer);
+            GPU::BindFramebuffer(m_framebuffer);
+            GPU::BindPipeline(pipeline);
+            // every pixel is overwritten with the base and the glow added to it
+            GPU::SetBlendingEnabled(false);
+
+            GPU::SetShaderUniform(pipeline.fragment, "uStage", 1);
+            GPU::SetShaderUniform(pipeline.fragment, "uResolution", resolution);
+            GPU::SetShaderUniform(pipeline.fragment, "uIntensity", intensity);
+            GPU::SetShaderUniform(pipeline.fragment, "uColor", color);
+            GPU::BindTextureToShader(pipeline.fragment, "uTexture", base.attachments.at(0), 0);
+            GPU::BindTextureToShader(pipeline.fragment, "uGlow", glowFramebuffer.attachments.at(0), 1);
+            GPU::DrawArrays(3);
+            GPU::SetBlendingEnabled(true);
+
+            RenderTargetPool::Release(glowFramebuffer);
+            RenderTargetPool::Consume(base);
+            TryAppendAbstractPinMap(result, "Output", m_framebuffer);
+        }
+
+        return result;
+    }
+
+    void Glow::AbstractRenderProperties() {
+        RenderAttributeProperty("Threshold");
+        RenderAttributeProperty("Softness");
+        RenderAttributeProperty("Radius");
+        RenderAttributeProperty("Intensity");
+        RenderAttributeProperty("Color");
+    }
+
+    void Glow::AbstractLoadSerialized(Json t_data) {
+        DeserializeAllAttributes(t_data);   
+    }
+
+    Json Glow::AbstractSerialize() {
+        return SerializeAllAttributes();
+    }
+
+    bool Glow::AbstractDetailsAvailable() {
+        return false;
+    }
+
+    std::string Glow::AbstractHeader() {
+        return "Glow";
+    }
+
+    std::string Glow::Icon() {
+        return ICON_FA_SUN;
+    }
+
+    std::optional<std::string> Glow::Footer() {
+        return std::nullopt;
+    }
+}
+
+extern "C" {
+    RASTER_DL_EXPORT Raster::AbstractNode SpawnNode() {
+        return (Raster::AbstractNode) std::make_shared<Raster::Glow>();
+    }
+
+    RASTER_DL_EXPORT Raster::NodeDescription GetDescription() {
+        return Raster::NodeDescription{
+            .prettyName = "Glow",
+            .packageName = RASTER_PACKAGED "glow",
+            .category = Raster::DefaultNodeCategories::s_rendering
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include "raster.h"
+#include "common/common.h"
+
+#include "compositor/compositor.h"
+#include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/pyramid_blur.h"
+#include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
+
+namespace Raster {
+    struct Glow : public NodeBase {
+        Glow();
+        
+        AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
+        void AbstractRenderProperties();
+        bool AbstractDetailsAvailable();
+
+        void AbstractLoadSerialized(Json t_data);
+        Json AbstractSerialize();
+
+        std::string AbstractHeader();
+        std::string Icon();
+        std::optional<std::string> Footer();
+    
+    private:
+        Framebuffer m_framebuffer;
+
+        // uStage 0 extracts the bright parts, uStage 1 adds their blurred version to the base
+        static PendingPipeline s_pipeline;
+    };
+};
\ No newline at end of file
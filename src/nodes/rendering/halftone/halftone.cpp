@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> Halftone::s_pipeline;
+    PendingPipeline Halftone::s_pipeline;
 
     Halftone::Halftone() {
         NodeBase::Initialize();
@@ -16,20 +16,14 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "halftone/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "halftone/shader")
             );
         }
     }
 
-    Halftone::~Halftone() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
-        }
-    }
-
     AbstractPinMap Halftone::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
 
@@ -38,15 +32,16 @@ namespace Raster {
         auto scaleCandidate = GetAttribute<float>("Scale");
         auto offsetCandidate = GetAttribute<glm::vec2>("Offset");
         auto colorCandidate = GetAttribute<glm::vec4>("Color");
-        if (s_pipeline.has_value() && baseCandidate.has_value() && offsetCandidate.has_value() && angleCandidate.has_value() && scaleCandidate.has_value() && colorCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && offsetCandidate.has_value() && angleCandidate.has_value() && scaleCandidate.has_value() && colorCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto& angle = angleCandidate.value();
             auto& scale = scaleCandidate.value();
             auto& offset = offsetCandidate.value();
             auto& color = colorCandidate.value();
 
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
 
             GPU::BindFramebuffer(m_framebuffer);
             GPU::BindPipeline(pipeline);
@@ -62,6 +57,7 @@ namespace Raster {
 
             GPU::DrawArrays(3);
 
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
 
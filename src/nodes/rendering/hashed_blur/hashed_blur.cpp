@@ -2,7 +2,8 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> HashedBlur::s_pipeline;
+    PendingPipeline HashedBlur::s_pipeline;
+    PendingPipeline HashedBlur::s_computePipeline;
 
     HashedBlur::HashedBlur() {
         NodeBase::Initialize();
@@ -15,17 +16,16 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "hashed_blur/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "hashed_blur/shader")
             );
         }
-    }
-
-    HashedBlur::~HashedBlur() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
+        if (!s_computePipeline.IsRequested()) {
+            s_computePipeline = ShaderCompiler::RequestComputePipeline(
+                ShaderCompiler::RequestShader(ShaderType::Compute, "hashed_blur/shader")
+            );
         }
     }
 
@@ -36,28 +36,59 @@ namespace Raster {
         auto radiusCandidate = GetAttribute<float>("Radius");
         auto hashOffsetCandidate = GetAttribute<glm::vec2>("HashOffset");
         auto iterationsCandidate = GetAttribute<int>("Iterations");
-        if (s_pipeline.has_value() && baseCandidate.has_value() && radiusCandidate.has_value() && hashOffsetCandidate.has_value() && iterationsCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        auto computePipelineCandidate = s_computePipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && radiusCandidate.has_value() && hashOffsetCandidate.has_value() && iterationsCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto& radius = radiusCandidate.value();
             auto& hashOffset = hashOffsetCandidate.value();
             auto& iterations = iterationsCandidate.value();
 
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
-
-            GPU::BindFramebuffer(m_framebuffer);
-            GPU::BindPipeline(pipeline);
-            GPU::ClearFramebuffer(0, 0, 0, 0);
-            
-            GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(m_framebuffer.width, m_framebuffer.height));
-            GPU::SetShaderUniform(pipeline.fragment, "uRadius", radius);
-            GPU::SetShaderUniform(pipeline.fragment, "uHashOffset", hashOffset);
-            GPU::SetShaderUniform(pipeline.fragment, "uIterations", iterations);
-
-            GPU::BindTextureToShader(pipeline.fragment, "uTexture", base.attachments.at(0), 0);
-
-            GPU::DrawArrays(3);
-
+            m_framebuffer = RenderTargetPool::Acquire();
+
+            // samples are spread over a rectangle of radius * 0.04 * (aspect, 1) in UV space
+            glm::vec2 resolution = glm::vec2(m_framebuffer.width, m_framebuffer.height);
+            glm::vec2 extent = glm::abs(radius) * 0.02f * glm::vec2(resolution.x / resolution.y, 1.0f) * resolution;
+
+            if (computePipelineCandidate.has_value() && TileCompute::IsApplicable(extent, base.attachments.at(0), m_framebuffer)) {
+                auto& computePipeline = computePipelineCandidate.value();
+                GPU::BindPipeline(computePipeline);
+
+                GPU::SetShaderUniform(computePipeline.compute, "uRadius", radius);
+                GPU::SetShaderUniform(computePipeline.compute, "uHashOffset", hashOffset);
+                GPU::SetShaderUniform(computePipeline.compute, "uIterations", iterations);
+
+                GPU::BindTextureToShader(computePipeline.compute, "uTexture", base.attachments.at(0), 0);
+
+                // every pixel is written, so the target does not have to be cleared first
+                TileCompute::Dispatch(computePipeline, m_framebuffer, std::nullopt, TileCompute::GetApron(extent));
+            } else {
+                // random taps further apart than a texel alias, so they read a level of the pyramid whose texels match their spacing
+                std::vector<Framebuffer> chain;
+                float tapSpacing = glm::max(extent.x, extent.y) * 2.0f / glm::sqrt((float) glm::max(iterations, 1));
+                int levels = glm::min((int) glm::floor(glm::log2(glm::max(tapSpacing, 1.0f))), PyramidBlur::GetLevels(tapSpacing, resolution));
+                if (levels > 0 && PyramidBlur::IsReady()) {
+                    chain = PyramidBlur::Downsample(base.attachments.at(0), levels);
+                }
+                Texture source = chain.empty() ? base.attachments.at(0) : chain.back().attachments.at(0);
+
+                GPU::BindFramebuffer(m_framebuffer);
+                GPU::BindPipeline(pipeline);
+                GPU::ClearFramebuffer(0, 0, 0, 0);
+                
+                GPU::SetShaderUniform(pipeline.fragment, "uResolution", resolution);
+                GPU::SetShaderUniform(pipeline.fragment, "uRadius", radius);
+                GPU::SetShaderUniform(pipeline.fragment, "uHashOffset", hashOffset);
+                GPU::SetShaderUniform(pipeline.fragment, "uIterations", iterations);
+
+                GPU::BindTextureToShader(pipeline.fragment, "uTexture", source, 0);
+
+                GPU::DrawArrays(3);
+                PyramidBlur::Release(chain);
+            }
+
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
 
@@ -4,12 +4,15 @@
 
 #include "compositor/compositor.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/tile_compute.h"
+#include "compositor/pyramid_blur.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 
 namespace Raster {
     struct HashedBlur : public NodeBase {
         HashedBlur();
-        ~HashedBlur();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -25,6 +28,8 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
+        // shared-memory tiled variant, used while the sampled disc fits into one tile
+        static PendingPipeline s_computePipeline;
     };
 };
\ No newline at end of file
@@ -10,7 +10,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> Layer2D::s_nullShapePipeline;
+    PendingPipeline Layer2D::s_nullShapePipeline;
 
     Layer2D::Layer2D() {
         NodeBase::Initialize();
@@ -28,15 +28,14 @@ namespace Raster {
         SetupAttribute("MaintainUVRange", true);
         SetupAttribute("AspectRatioCorrection", false);
 
-        if (!s_nullShapePipeline.has_value()) {
+        if (!s_nullShapePipeline.IsRequested()) {
             s_nullShapePipeline = GeneratePipelineFromShape(SDFShape()).pipeline;
         }
 
-        this->m_sampler = GPU::GenerateSampler();
+        this->m_resolvedPipeline = nullptr;
     }
 
     Layer2D::~Layer2D() {
-        GPU::DestroySampler(m_sampler);
     }
 
     AbstractPinMap Layer2D::AbstractExecute(AbstractPinMap t_accumulator) {
@@ -76,40 +75,39 @@ namespace Raster {
 
             GPU::BindFramebuffer(framebuffer);
             GPU::BindPipeline(pipeline);
-
-
-            GPU::SetShaderUniform(pipeline.vertex, "uMatrix", project.GetProjectionMatrix() * transform.GetTransformationMatrix());
-
-            GPU::SetShaderUniform(pipeline.fragment, "uMaintainUVRange", maintainUVRange);
-            GPU::SetShaderUniform(pipeline.fragment, "uAspectRatioCorrection", aspectRatioCorrection);
+            ResolveUniforms(pipeline);
+
+            auto matrix = project.GetProjectionMatrix() * transform.GetTransformationMatrix();
+            GPU::SetShaderUniform(m_matrixUniform, matrix);
+
+            Layer2DParameters parameters = {};
+            parameters.color = color;
+            parameters.uvPosition = uvPosition;
+            parameters.uvSize = uvSize;
+            parameters.uvAngle = glm::radians(uvAngle);
+            parameters.textureAvailable = texture.handle ? 1 : 0;
+            parameters.maintainUVRange = maintainUVRange ? 1 : 0;
+            parameters.aspectRatioCorrection = aspectRatioCorrection ? 1 : 0;
             if (aspectRatioCorrection) {
                 glm::vec2 decomposedSize = transform.DecomposeSize();
-                GPU::SetShaderUniform(pipeline.fragment, "uAspectRatio", decomposedSize.x / decomposedSize.y);
+                parameters.aspectRatio = decomposedSize.x / decomposedSize.y;
             }
-            GPU::SetShaderUniform(pipeline.fragment, "uUVPosition", uvPosition);
-            GPU::SetShaderUniform(pipeline.fragment, "uUVSize", uvSize);
-            GPU::SetShaderUniform(pipeline.fragment, "uUVAngle", glm::radians(uvAngle));
-            GPU::SetShaderUniform(pipeline.fragment, "uColor", color);
-            GPU::SetShaderUniform(pipeline.fragment, "uTextureAvailable", texture.handle ? 1 : 0);
+            GPU::BindUniformBlock(GPU::UploadUniformBlock(&parameters, sizeof(parameters)), 0);
 
             SetShapeUniforms(shape, pipeline);
 
             if (texture.handle) {
-                GPU::BindTextureToShader(pipeline.fragment, "uTexture", texture, 0);
-                GPU::BindSampler(m_sampler, 0);
-                bool filteringModeMatches = m_sampler.magnifyMode == samplerSettings.filteringMode && m_sampler.minifyMode == samplerSettings.filteringMode;
-                bool wrappingModeMatches = m_sampler.sMode == samplerSettings.wrappingMode && m_sampler.tMode == samplerSettings.wrappingMode;
-                if (!filteringModeMatches || !wrappingModeMatches) {
-                    GPU::SetSamplerTextureFilteringMode(m_sampler, TextureFilteringOperation::Magnify, samplerSettings.filteringMode);
-                    GPU::SetSamplerTextureFilteringMode(m_sampler, TextureFilteringOperation::Minify, samplerSettings.filteringMode);
-
-                    GPU::SetSamplerTextureWrappingMode(m_sampler, TextureWrappingAxis::S, samplerSettings.wrappingMode);
-                    GPU::SetSamplerTextureWrappingMode(m_sampler, TextureWrappingAxis::T, samplerSettings.wrappingMode);
-                }
+                GPU::BindTextureToShader(m_textureUniform, texture, 0);
+                GPU::BindSampler(GPU::GetSampler(samplerSettings.wrappingMode, samplerSettings.filteringMode), 0);
             }
             GPU::DrawArrays(6);
 
             GPU::BindSampler(std::nullopt);
+            RenderTargetPool::Consume(texture);
+
+            // the quad can't add anything outside of its own screen rectangle
+            bool opaque = framebuffer.opaque && ContentBounds::CoversFramebuffer(framebuffer.bounds, framebuffer);
+            RenderTargetPool::SetContentBounds(framebuffer, ContentBounds::Union(framebuffer.bounds, ContentBounds::FromQuad(matrix, framebuffer)), opaque);
 
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
         }
@@ -117,6 +115,13 @@ namespace Raster {
         return result;
     }
 
+    void Layer2D::ResolveUniforms(Pipeline& t_pipeline) {
+        if (m_resolvedPipeline == t_pipeline.handle) return;
+        this->m_matrixUniform = GPU::GetUniformHandle(t_pipeline.vertex, "uMatrix");
+        this->m_textureUniform = GPU::GetUniformHandle(t_pipeline.fragment, "uTexture");
+        this->m_resolvedPipeline = t_pipeline.handle;
+    }
+
     void Layer2D::SetShapeUniforms(SDFShape t_shape, Pipeline pipeline) {
         for (auto& uniform : t_shape.uniforms) {
             UNIFORM_CLAUSE(uniform, float);
@@ -160,10 +165,11 @@ namespace Raster {
         auto& shape = shapeCandidate.value();
         if (shape.uniforms.empty()) {
             if (m_pipeline.has_value()) {
-                GPU::DestroyPipeline(m_pipeline.value().pipeline);
+                m_pipeline.value().pipeline.Destroy();
+                this->m_resolvedPipeline = nullptr;
                 m_pipeline = std::nullopt;
             }
-            return s_nullShapePipeline;
+            return s_nullShapePipeline.Get();
         }
         if (!m_pipeline.has_value()) {
             m_pipeline = GeneratePipelineFromShape(shape);
@@ -171,11 +177,13 @@ namespace Raster {
 
         auto& pipeline = m_pipeline.value();
         if (pipeline.shape.id != shape.id) {
-            GPU::DestroyPipeline(pipeline.pipeline);
+            pipeline.pipeline.Destroy();
+            this->m_resolvedPipeline = nullptr;
             m_pipeline = GeneratePipelineFromShape(shape);
         }
 
-        return m_pipeline.value().pipeline;
+        // the layer is skipped until the program of the new shape has been compiled
+        return m_pipeline.value().pipeline.Get();
     }
 
     SDFShapePipeline Layer2D::GeneratePipelineFromShape(SDFShape t_shape) {
@@ -193,17 +201,12 @@ namespace Raster {
         shaderBase = ReplaceString(shaderBase, "SDF_DISTANCE_FUNCTION_PLACEHOLDER", t_shape.distanceFunctionName);
         shaderBase = ReplaceString(shaderBase, "SDF_DISTANCE_FUNCTIONS_PLACEHOLDER", t_shape.distanceFunctionCode);
 
-        std::string clearShaderFile = "layer2d/generated_shape_pipeline" + std::to_string(nodeID);
-        std::string shaderFile = GPU::GetShadersPath() + clearShaderFile + ".frag";
-        WriteFile(shaderFile, shaderBase);
-
-        Pipeline generatedPipeline = GPU::GeneratePipeline(
-            GPU::GenerateShader(ShaderType::Vertex, "layer2d/shader"),
-            GPU::GenerateShader(ShaderType::Fragment, clearShaderFile, false)
+        // layers with the same shape share one cache entry, the binary survives between sessions
+        PendingPipeline generatedPipeline = ShaderCompiler::RequestPipeline(
+            ShaderCompiler::RequestShader(ShaderType::Vertex, "layer2d/shader"),
+            ShaderCompiler::RequestShaderFromSource(ShaderType::Fragment, "layer2d/" + t_shape.distanceFunctionName, shaderBase)
         );
 
-        std::filesystem::remove(shaderFile);
-
         return SDFShapePipeline{
             .shape = t_shape,
             .pipeline = generatedPipeline,
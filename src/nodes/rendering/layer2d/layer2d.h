@@ -2,9 +2,12 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/compositor.h"
 #include "compositor/managed_framebuffer.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
 #include "common/transform2d.h"
 #include "raster.h"
 
@@ -42,10 +45,23 @@ namespace Raster {
 
     struct SDFShapePipeline {
         SDFShape shape;
-        Pipeline pipeline;
+        PendingPipeline pipeline;
         std::string shaderCode;
     };
 
+    // std140 layout of the Layer2DParameters block in layer2d/shader_base.frag
+    struct Layer2DParameters {
+        glm::vec4 color;
+        glm::vec2 uvPosition;
+        glm::vec2 uvSize;
+        float uvAngle;
+        float aspectRatio;
+        int textureAvailable;
+        int maintainUVRange;
+        int aspectRatioCorrection;
+        float padding[3];
+    };
+
     struct Layer2D : public NodeBase {
     public:
         Layer2D();
@@ -70,11 +86,15 @@ namespace Raster {
         SDFShapePipeline GeneratePipelineFromShape(SDFShape t_shape);
 
         void SetShapeUniforms(SDFShape t_shape, Pipeline pipeline);
+        // handles are resolved again only when the shape pipeline changes
+        void ResolveUniforms(Pipeline& t_pipeline);
 
-        Sampler m_sampler;
         ManagedFramebuffer m_managedFramebuffer;
         std::optional<SDFShapePipeline> m_pipeline;
 
-        static std::optional<Pipeline> s_nullShapePipeline;
+        void* m_resolvedPipeline;
+        UniformHandle m_matrixUniform, m_textureUniform;
+
+        static PendingPipeline s_nullShapePipeline;
     };
 };
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> LensDistortion::s_pipeline;
+    PendingPipeline LensDistortion::s_pipeline;
 
     LensDistortion::LensDistortion() {
         NodeBase::Initialize();
@@ -17,18 +17,14 @@ namespace Raster {
 
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "lens_distortion/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "lens_distortion/shader")
             );
         }
     }
 
-    LensDistortion::~LensDistortion() {
-        GPU::DestroyFramebufferWithAttachments(m_framebuffer);
-    }
-
     AbstractPinMap LensDistortion::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
         
@@ -40,8 +36,9 @@ namespace Raster {
         auto dispersionCandidate = GetAttribute<float>("Dispersion");
         auto darkEdgesCandidate = GetAttribute<bool>("DarkEdges");
 
-        if (s_pipeline.has_value() && baseCandidate.has_value() && k1Candidate.has_value() && k2Candidate.has_value() && k3Candidate.has_value() && darkEdgesCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && k1Candidate.has_value() && k2Candidate.has_value() && k3Candidate.has_value() && darkEdgesCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto& k1 = k1Candidate.value();
             auto& k2 = k2Candidate.value();
@@ -49,7 +46,7 @@ namespace Raster {
             auto& edge = edgeCandidate.value();
             auto& dispersion = dispersionCandidate.value();
             auto& darkEdges = darkEdgesCandidate.value();
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
             GPU::BindFramebuffer(m_framebuffer);
             GPU::BindPipeline(pipeline);
             GPU::ClearFramebuffer(0, 0, 0, 0);
@@ -65,6 +62,7 @@ namespace Raster {
 
             GPU::DrawArrays(3);
 
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
 
         }
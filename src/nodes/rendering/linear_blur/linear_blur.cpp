@@ -2,7 +2,8 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> LinearBlur::s_pipeline;
+    PendingPipeline LinearBlur::s_pipeline;
+    PendingPipeline LinearBlur::s_computePipeline;
 
     LinearBlur::LinearBlur() {
         NodeBase::Initialize();
@@ -11,21 +12,21 @@ namespace Raster {
         SetupAttribute("Angle", 0.0f);
         SetupAttribute("Intensity", 1.0f);
         SetupAttribute("Samples", 50);
+        SetupAttribute("Gaussian", false);
 
         AddInputPin("Base");
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "linear_blur/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "separable_blur/shader")
             );
         }
-    }
-
-    LinearBlur::~LinearBlur() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
+        if (!s_computePipeline.IsRequested()) {
+            s_computePipeline = ShaderCompiler::RequestComputePipeline(
+                ShaderCompiler::RequestShader(ShaderType::Compute, "linear_blur/shader")
+            );
         }
     }
 
@@ -36,31 +37,47 @@ namespace Raster {
         auto angleCandidate = GetAttribute<float>("Angle");
         auto intensityCandidate = GetAttribute<float>("Intensity");
         auto samplesCandidate = GetAttribute<int>("Samples");
+        auto gaussianCandidate = GetAttribute<bool>("Gaussian");
         
-        if (s_pipeline.has_value() && baseCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        auto computePipelineCandidate = s_computePipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto angle = glm::radians(angleCandidate.value());
             auto& intensity = intensityCandidate.value();
-            auto samples = (float) samplesCandidate.value();    
+            auto samples = samplesCandidate.value();
+            auto shape = gaussianCandidate.value_or(false) ? KernelShape::Gaussian : KernelShape::Box;
 
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
             glm::vec2 direction = glm::vec2(glm::cos(angle), glm::sin(angle));
             direction *= 0.1f * intensity;
-            direction *= glm::vec2(m_framebuffer.width, m_framebuffer.height);
+            direction *= Compositor::GetOutputResolution();
+            Compositor::ReportSamplingRadius(direction * 0.5f);
+
+            glm::vec2 extent = glm::abs(direction) * 0.5f;
+            auto bounds = ContentBounds::Expand(base.bounds, glm::ivec2(glm::ceil(extent)) + 1, m_framebuffer);
+            RenderTargetPool::ClearTarget(m_framebuffer);
+
+            float length = glm::length(direction);
+            glm::vec2 unitDirection = length > 0.0f ? direction / length : glm::vec2(1, 0);
+            auto taps = SeparableKernel::Generate(shape, length, samples);
 
-            GPU::BindFramebuffer(m_framebuffer);
-            GPU::BindPipeline(pipeline);
-            GPU::ClearFramebuffer(0, 0, 0, 0);
+            if (computePipelineCandidate.has_value() && TileCompute::IsApplicable(extent, base.attachments.at(0), m_framebuffer)) {
+                auto& computePipeline = computePipelineCandidate.value();
+                GPU::BindPipeline(computePipeline);
 
-            GPU::BindTextureToShader(pipeline.fragment, "uTexture", base.attachments.at(0), 0);
-            GPU::SetShaderUniform(pipeline.fragment, "uLinearBlurIntensity", direction);
-            GPU::SetShaderUniform(pipeline.fragment, "uSamples", samples);
+                GPU::BindTextureToShader(computePipeline.compute, "uTexture", base.attachments.at(0), 0);
+                GPU::SetShaderUniform(computePipeline.compute, "uDirection", unitDirection);
+                GPU::BindUniformBlock(GPU::UploadUniformBlock(&taps, sizeof(taps)), 0);
 
-            GPU::SetShaderUniform(pipeline.fragment, "uResolution", glm::vec2(m_framebuffer.width, m_framebuffer.height));
-            
-            GPU::DrawArrays(3);
+                TileCompute::Dispatch(computePipeline, m_framebuffer, bounds, TileCompute::GetApron(extent));
+            } else {
+                SeparableKernel::Apply(pipeline, base.attachments.at(0), m_framebuffer, unitDirection, taps, bounds);
+            }
 
+            RenderTargetPool::SetContentBounds(m_framebuffer, bounds);
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
 
@@ -72,6 +89,7 @@ namespace Raster {
         RenderAttributeProperty("Angle");
         RenderAttributeProperty("Intensity");
         RenderAttributeProperty("Samples");
+        RenderAttributeProperty("Gaussian");
     }
 
     void LinearBlur::AbstractLoadSerialized(Json t_data) {
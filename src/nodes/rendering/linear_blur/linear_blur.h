@@ -4,12 +4,16 @@
 
 #include "compositor/compositor.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
+#include "compositor/tile_compute.h"
+#include "compositor/separable_kernel.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 
 namespace Raster {
     struct LinearBlur : public NodeBase {
         LinearBlur();
-        ~LinearBlur();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -25,6 +29,9 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        // separable_blur/shader
+        static PendingPipeline s_pipeline;
+        // shared-memory tiled variant, used while the line fits into one tile
+        static PendingPipeline s_computePipeline;
     };
 };
\ No newline at end of file
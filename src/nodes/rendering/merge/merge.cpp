@@ -16,15 +16,6 @@ namespace Raster {
         AddOutputPin("Output");
     }
 
-    Merge::~Merge() {
-        if (m_framebuffer.handle) {
-            for (auto& attachment : m_framebuffer.attachments) {
-                GPU::DestroyTexture(attachment);
-            }
-            GPU::DestroyFramebuffer(m_framebuffer);
-        }
-    }
-
     AbstractPinMap Merge::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
         auto aCandidate = TextureInteroperability::GetFramebuffer(GetDynamicAttribute("A"));
@@ -33,7 +24,7 @@ namespace Raster {
         auto blendingModeCandidate = GetAttribute<std::string>("BlendingMode");
 
         if (aCandidate.has_value() && bCandidate.has_value() && opacityCandidate.has_value() && blendingModeCandidate.has_value() && aCandidate.value().attachments.size() > 1 && bCandidate.value().attachments.size() > 1) {
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
             auto& a = aCandidate.value();
             auto& b = bCandidate.value();
             auto& opacity = opacityCandidate.value();
@@ -44,17 +35,24 @@ namespace Raster {
                 .colorAttachment = a.attachments.at(0),
                 .uvAttachment = a.attachments.size() > 1 ? a.attachments.at(1) : Texture(),
                 .opacity = 1.0f,
-                .blendMode = "",
-                .compositionID = -1
+                .blendModeIndex = -1,
+                .compositionID = -1,
+                .bounds = a.bounds,
+                .opaque = a.opaque
             });
             targets.push_back(CompositorTarget{
                 .colorAttachment = b.attachments.at(0),
                 .uvAttachment = b.attachments.size() > 1 ? b.attachments.at(1) : Texture(),
                 .opacity = opacity,
-                .blendMode = blendingMode,
-                .compositionID = -1
+                .blendModeIndex = Compositor::s_blending.GetModeIndexByCodeName(blendingMode).value_or(-1),
+                .compositionID = -1,
+                .bounds = b.bounds,
+                .opaque = b.opaque
             });
             Compositor::PerformManualComposition(targets, m_framebuffer, glm::vec4(0));
+            RenderTargetPool::SetContentBounds(m_framebuffer, ContentBounds::Union(a.bounds, b.bounds), a.opaque && ContentBounds::CoversFramebuffer(a.bounds, m_framebuffer));
+            RenderTargetPool::Consume(a);
+            RenderTargetPool::Consume(b);
 
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
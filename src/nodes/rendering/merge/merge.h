@@ -3,6 +3,8 @@
 #include "common/common.h"
 #include "compositor/compositor.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
 #include "font/font.h"
 #include "../../../ImGui/imgui.h"
 #include "../../../ImGui/imgui_stdlib.h"
@@ -11,7 +13,6 @@ namespace Raster {
     struct Merge : public NodeBase {
     public:
         Merge();
-        ~Merge();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
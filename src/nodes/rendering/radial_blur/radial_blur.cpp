@@ -2,7 +2,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> RadialBlur::s_pipeline;
+    PendingPipeline RadialBlur::s_pipeline;
 
     RadialBlur::RadialBlur() {
         NodeBase::Initialize();
@@ -15,20 +15,14 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Output");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "radial_blur/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "radial_blur/shader")
             );
         }
     }
 
-    RadialBlur::~RadialBlur() {
-        if (m_framebuffer.handle) {
-            GPU::DestroyFramebufferWithAttachments(m_framebuffer);
-        }
-    }
-
     AbstractPinMap RadialBlur::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
 
@@ -37,14 +31,15 @@ namespace Raster {
         auto centerCandidate = GetAttribute<glm::vec2>("Center");
         auto samplesCandidate = GetAttribute<int>("Samples");
         
-        if (s_pipeline.has_value() && baseCandidate.has_value() && intensityCandidate.has_value() && centerCandidate.has_value() && samplesCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && intensityCandidate.has_value() && centerCandidate.has_value() && samplesCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& base = baseCandidate.value();
             auto& intensity = intensityCandidate.value();
             auto& center = centerCandidate.value();
             auto samples = (float) samplesCandidate.value();    
 
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
+            m_framebuffer = RenderTargetPool::Acquire();
 
             intensity *= 0.1f;
             intensity *= glm::vec2(m_framebuffer.width, m_framebuffer.height);
@@ -62,6 +57,7 @@ namespace Raster {
             
             GPU::DrawArrays(3);
 
+            RenderTargetPool::Consume(base);
             TryAppendAbstractPinMap(result, "Output", m_framebuffer);
         }
 
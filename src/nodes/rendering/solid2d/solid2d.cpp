@@ -7,7 +7,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> Solid2D::s_pipeline;
+    PendingPipeline Solid2D::s_pipeline;
 
     Solid2D::Solid2D() {
         NodeBase::Initialize();
@@ -19,10 +19,10 @@ namespace Raster {
         SetupAttribute("Color", glm::vec4(1));
         SetupAttribute("Transform", Transform2D());
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::GenerateShader(ShaderType::Vertex, "solid2d/shader"),
-                GPU::GenerateShader(ShaderType::Fragment, "solid2d/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::RequestShader(ShaderType::Vertex, "solid2d/shader"),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "solid2d/shader")
             );
         }
     }
@@ -36,19 +36,24 @@ namespace Raster {
         auto transformCandidate = GetAttribute<Transform2D>("Transform");
         auto colorCandidate = GetAttribute<glm::vec4>("Color");
 
-        if (s_pipeline.has_value() && transformCandidate.has_value() && colorCandidate.has_value()) {
-            auto& pipeline = s_pipeline.value();
+        auto pipelineCandidate = s_pipeline.Get();
+        if (pipelineCandidate.has_value() && transformCandidate.has_value() && colorCandidate.has_value()) {
+            auto& pipeline = pipelineCandidate.value();
             auto& transform = transformCandidate.value();
             auto& color = colorCandidate.value();
 
             GPU::BindFramebuffer(framebuffer);
             GPU::BindPipeline(pipeline);
 
-            GPU::SetShaderUniform(pipeline.vertex, "uMatrix", project.GetProjectionMatrix() * transform.GetTransformationMatrix());
+            auto matrix = project.GetProjectionMatrix() * transform.GetTransformationMatrix();
+            GPU::SetShaderUniform(pipeline.vertex, "uMatrix", matrix);
             GPU::SetShaderUniform(pipeline.fragment, "uColor", color);
 
             GPU::DrawArrays(6);
 
+            bool opaque = framebuffer.opaque && ContentBounds::CoversFramebuffer(framebuffer.bounds, framebuffer);
+            RenderTargetPool::SetContentBounds(framebuffer, ContentBounds::Union(framebuffer.bounds, ContentBounds::FromQuad(matrix, framebuffer)), opaque);
+
             TryAppendAbstractPinMap(result, "Framebuffer", framebuffer);
         }
 
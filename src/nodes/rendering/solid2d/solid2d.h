@@ -2,9 +2,12 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/compositor.h"
 #include "compositor/managed_framebuffer.h"
 #include "compositor/texture_interoperability.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
 #include "common/transform2d.h"
 #include "raster.h"
 
@@ -27,6 +30,6 @@ namespace Raster {
     private:
         ManagedFramebuffer m_managedFramebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
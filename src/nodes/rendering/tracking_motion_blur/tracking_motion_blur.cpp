@@ -2,8 +2,8 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> TrackingMotionBlur::s_pipeline;
-    std::optional<Sampler> TrackingMotionBlur::s_sampler;
+    PendingPipeline TrackingMotionBlur::s_pipeline;
+    PendingPipeline TrackingMotionBlur::s_computePipeline;
 
     TrackingMotionBlur::TrackingMotionBlur() {
         NodeBase::Initialize();
@@ -16,31 +16,16 @@ namespace Raster {
         AddInputPin("Base");
         AddOutputPin("Framebuffer");
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::s_basicShader,
-                GPU::GenerateShader(ShaderType::Fragment, "tracking_motion_blur/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::Ready(GPU::s_basicShader),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "tracking_motion_blur/shader")
             );
-
-            s_sampler = GPU::GenerateSampler();
-            GPU::SetSamplerTextureWrappingMode(s_sampler.value(), TextureWrappingAxis::S, TextureWrappingMode::MirroredRepeat);
-            GPU::SetSamplerTextureWrappingMode(s_sampler.value(), TextureWrappingAxis::T, TextureWrappingMode::MirroredRepeat);
-        }
-    }
-
-    TrackingMotionBlur::~TrackingMotionBlur() {
-        if (m_framebuffer.handle) {
-            for (auto& attachment : m_framebuffer.attachments) {
-                GPU::DestroyTexture(attachment);
-            }
-            GPU::DestroyFramebuffer(m_framebuffer);
         }
-
-        if (m_temporalFramebuffer.handle) {
-            for (auto& attachment : m_temporalFramebuffer.attachments) {
-                GPU::DestroyTexture(attachment);
-            }
-            GPU::DestroyFramebuffer(m_temporalFramebuffer);
+        if (!s_computePipeline.IsRequested()) {
+            s_computePipeline = ShaderCompiler::RequestComputePipeline(
+                ShaderCompiler::RequestShader(ShaderType::Compute, "tracking_motion_blur/shader")
+            );
         }
     }
 
@@ -52,15 +37,17 @@ namespace Raster {
         auto baseTransformCandidate = GetAttribute<Transform2D>("Transform");
         auto blurIntensityCandidate = GetAttribute<float>("BlurIntensity");
         auto samplesCandidate = GetAttribute<int>("Samples");
-        if (s_pipeline.has_value() && s_sampler.has_value() && baseCandidate.has_value() && baseTransformCandidate.has_value() && blurIntensityCandidate.has_value() && samplesCandidate.has_value() && baseCandidate.value().attachments.size() > 0) {
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_framebuffer);
-            Compositor::EnsureResolutionConstraintsForFramebuffer(m_temporalFramebuffer);
+        auto pipelineCandidate = s_pipeline.Get();
+        auto computePipelineCandidate = s_computePipeline.Get();
+        if (pipelineCandidate.has_value() && baseCandidate.has_value() && baseTransformCandidate.has_value() && blurIntensityCandidate.has_value() && samplesCandidate.has_value() && baseCandidate.value().attachments.size() > 0) {
+            m_framebuffer = RenderTargetPool::Acquire();
+            m_temporalFramebuffer = RenderTargetPool::Acquire();
             float aspect = (float) m_framebuffer.width / (float) m_framebuffer.height;
             auto& base = baseCandidate.value();
             auto& baseTransform = baseTransformCandidate.value();
             auto& blurIntensity = blurIntensityCandidate.value();
-            auto& pipeline = s_pipeline.value();
-            auto& sampler = s_sampler.value();
+            auto& pipeline = pipelineCandidate.value();
+            auto sampler = GPU::GetSampler(TextureWrappingMode::MirroredRepeat, TextureFilteringMode::Linear);
             auto& samples = samplesCandidate.value();
             
             project.TimeTravel(-1);
@@ -110,6 +97,7 @@ namespace Raster {
 
                 GPU::BindTextureToShader(pipeline.fragment, "uTexture", base.attachments.at(0), 0);
                 GPU::DrawArrays(3);
+                RenderTargetPool::Consume(base);
 
                 GPU::BindFramebuffer(m_temporalFramebuffer);
                 GPU::ClearFramebuffer(0, 0, 0, 0);
@@ -119,15 +107,33 @@ namespace Raster {
 
                 GPU::DrawArrays(3);
 
-                GPU::BindFramebuffer(m_framebuffer);
-                GPU::ClearFramebuffer(0, 0, 0, 0);
+                GPU::BindSampler(std::nullopt, 0);
 
-                GPU::SetShaderUniform(pipeline.fragment, "uStage", 0);
-                GPU::BindTextureToShader(pipeline.fragment, "uTexture", m_temporalFramebuffer.attachments.at(0), 0);
+                // the linear stage is the only one with a footprint bounded by its uniforms
+                glm::vec2 linearExtent = glm::abs(positionDifference) * 0.5f;
+                if (computePipelineCandidate.has_value() && TileCompute::IsApplicable(linearExtent, m_temporalFramebuffer.attachments.at(0), m_framebuffer)) {
+                    auto& computePipeline = computePipelineCandidate.value();
+                    GPU::BindPipeline(computePipeline);
 
-                GPU::DrawArrays(3);
+                    GPU::SetShaderUniform(computePipeline.compute, "uLinearBlurIntensity", positionDifference);
+                    GPU::SetShaderUniform(computePipeline.compute, "uSamples", (float) samples);
+                    GPU::BindTextureToShader(computePipeline.compute, "uTexture", m_temporalFramebuffer.attachments.at(0), 0);
 
-                GPU::BindSampler(std::nullopt, 0);
+                    // every pixel is written, so the target does not have to be cleared first
+                    TileCompute::Dispatch(computePipeline, m_framebuffer, std::nullopt, TileCompute::GetApron(linearExtent));
+                } else {
+                    GPU::BindFramebuffer(m_framebuffer);
+                    GPU::BindSampler(sampler, 0);
+                    GPU::ClearFramebuffer(0, 0, 0, 0);
+
+                    GPU::SetShaderUniform(pipeline.fragment, "uStage", 0);
+                    GPU::BindTextureToShader(pipeline.fragment, "uTexture", m_temporalFramebuffer.attachments.at(0), 0);
+
+                    GPU::DrawArrays(3);
+
+                    GPU::BindSampler(std::nullopt, 0);
+                }
+                RenderTargetPool::Release(m_temporalFramebuffer);
 
                 TryAppendAbstractPinMap(result, "Framebuffer", m_framebuffer);
 
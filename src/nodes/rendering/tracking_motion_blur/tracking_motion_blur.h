@@ -2,14 +2,16 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/compositor.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/tile_compute.h"
 #include "common/transform2d.h"
 
 namespace Raster {
     struct TrackingMotionBlur : public NodeBase {
     public:
         TrackingMotionBlur();
-        ~TrackingMotionBlur();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -24,7 +26,8 @@ namespace Raster {
     private:
         Framebuffer m_framebuffer, m_temporalFramebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
-        static std::optional<Sampler> s_sampler;
+        static PendingPipeline s_pipeline;
+        // shared-memory tiled variant of the linear stage
+        static PendingPipeline s_computePipeline;
     };
 };
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include "raster.h"
+#include "common/common.h"
+
+namespace Raster {
+    struct GetAssetFrame : public NodeBase {
+        GetAssetFrame();
+        
+        AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
+        void AbstractRenderProperties();
+        bool AbstractDetailsAvailable();
+
+        void AbstractLoadSerialized(Json t_data);
+        Json AbstractSerialize();
+
+        std::string AbstractHeader();
+        std::string Icon();
+        std::optional<std::string> Footer();
+    };
+};
\ No newline at end of file
@@ -15,11 +15,13 @@ namespace Raster {
 
         this->archive = std::nullopt;
         this->m_asyncUploadID = 0;
+        this->m_residencyID = 0;
     }
 
     LoadTextureByPath::~LoadTextureByPath() {
         if (archive.has_value()) {
             auto& archiveValue = archive.value();
+            TextureResidency::Unregister(m_residencyID);
             GPU::DestroyTexture(archiveValue.texture);
         }
     }
@@ -27,6 +29,11 @@ namespace Raster {
     AbstractPinMap LoadTextureByPath::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
 
+        // textures evicted while the node wasn't executed are loaded again through the async path
+        if (archive.has_value() && !TextureResidency::Touch(m_residencyID)) {
+            archive = std::nullopt;
+            m_residencyID = 0;
+        }
         if (!archive.has_value()) UpdateTextureArchive();
         
         if (archive.has_value()) {
@@ -44,9 +51,12 @@ namespace Raster {
         std::string path = GetAttribute<std::string>("Path").value_or("");
         if (std::filesystem::exists(path) && !std::filesystem::is_directory(path)) {
             if (!m_loader.IsInitialized() && !m_asyncUploadID) {
-                m_loader = AsyncImageLoader(path);
+                ImageLoaderOptions options;
+                options.useDiskCache = true;
+                m_loader = AsyncImageLoader(path, options);
                 if (archive.has_value()) {
                     auto& textureArchive = archive.value();
+                    TextureResidency::Unregister(m_residencyID);
                     AsyncUpload::DestroyTexture(textureArchive.texture);
                 }
                 archive = std::nullopt;
@@ -70,6 +80,7 @@ namespace Raster {
             if (AsyncUpload::IsUploadReady(m_asyncUploadID)) {
                 auto& info = AsyncUpload::GetUpload(m_asyncUploadID);
                 archive = TextureArchive(info.texture, path);
+                m_residencyID = TextureResidency::Register(info.texture);
                 AsyncUpload::DestroyUpload(m_asyncUploadID);
             }
         }
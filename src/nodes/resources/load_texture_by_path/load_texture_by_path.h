@@ -4,6 +4,7 @@
 #include "gpu/gpu.h"
 #include "image/image.h"
 #include "gpu/async_upload.h"
+#include "gpu/texture_residency.h"
 
 namespace Raster {
 
@@ -39,6 +40,7 @@ namespace Raster {
 
     private:
         AsyncUploadInfoID m_asyncUploadID;
+        TextureResidencyID m_residencyID;
         AsyncImageLoader m_loader;
     };
 };
\ No newline at end of file
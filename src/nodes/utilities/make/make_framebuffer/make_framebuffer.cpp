@@ -6,7 +6,7 @@
 
 namespace Raster {
 
-    std::optional<Pipeline> MakeFramebuffer::s_pipeline;
+    PendingPipeline MakeFramebuffer::s_pipeline;
 
     MakeFramebuffer::MakeFramebuffer() {
         NodeBase::Initialize();
@@ -16,24 +16,14 @@ namespace Raster {
         SetupAttribute("BackgroundColor", glm::vec4(1));
         SetupAttribute("BackgroundTexture", Texture());
 
-        if (!s_pipeline.has_value()) {
-            s_pipeline = GPU::GeneratePipeline(
-                GPU::GenerateShader(ShaderType::Vertex, "make_framebuffer/shader"),
-                GPU::GenerateShader(ShaderType::Fragment, "make_framebuffer/shader")
+        if (!s_pipeline.IsRequested()) {
+            s_pipeline = ShaderCompiler::RequestPipeline(
+                ShaderCompiler::RequestShader(ShaderType::Vertex, "make_framebuffer/shader"),
+                ShaderCompiler::RequestShader(ShaderType::Fragment, "make_framebuffer/shader")
             );
         }
     }
 
-    MakeFramebuffer::~MakeFramebuffer() {
-        if (m_internalFramebuffer.has_value()) {
-            auto& framebuffer = m_internalFramebuffer.value();
-            for (auto& attachment : framebuffer.attachments) {
-                GPU::DestroyTexture(attachment);
-            }
-            GPU::DestroyFramebuffer(framebuffer);
-        }
-    }
-
     AbstractPinMap MakeFramebuffer::AbstractExecute(AbstractPinMap t_accumulator) {
         AbstractPinMap result = {};
 
@@ -41,30 +31,27 @@ namespace Raster {
         if (backgroundColorCandidate.has_value()) {
             auto& backgroundColor = backgroundColorCandidate.value();
             auto requiredResolution = Compositor::GetRequiredResolution();
-            if (!m_internalFramebuffer.has_value() || m_internalFramebuffer.value().width != (int) requiredResolution.x || m_internalFramebuffer.value().height != (int) requiredResolution.y) {
-                if (m_internalFramebuffer.has_value()) {
-                    auto& framebuffer = m_internalFramebuffer.value();
-                    for (auto& attachment : framebuffer.attachments) {
-                        GPU::DestroyTexture(attachment);
-                    }
-                    GPU::DestroyFramebuffer(framebuffer);
-                }
-                m_internalFramebuffer = Compositor::GenerateCompatibleFramebuffer(requiredResolution);
-            }
+            m_internalFramebuffer = RenderTargetPool::Acquire(requiredResolution);
 
-            if (m_internalFramebuffer.has_value() && s_pipeline.has_value()) {
+            auto pipelineCandidate = s_pipeline.Get();
+            if (m_internalFramebuffer.has_value() && pipelineCandidate.has_value()) {
                 auto backgroundTextureCandidate = GetAttribute<Texture>("BackgroundTexture");
                 auto& framebuffer = m_internalFramebuffer.value();
                 GPU::BindFramebuffer(framebuffer);
                 GPU::ClearFramebuffer(backgroundColor.r, backgroundColor.g, backgroundColor.b, backgroundColor.a);
-                if (backgroundTextureCandidate.has_value() && backgroundTextureCandidate.value().handle) {
-                    auto& pipeline = s_pipeline.value();
+                bool hasTexture = backgroundTextureCandidate.has_value() && backgroundTextureCandidate.value().handle;
+                // a transparent background without a texture is empty, an opaque one covers everything
+                bool transparent = !hasTexture && backgroundColor == glm::vec4(0);
+                RenderTargetPool::SetContentBounds(framebuffer, transparent ? std::optional<glm::ivec4>(ContentBounds::Empty()) : std::nullopt, !hasTexture && backgroundColor.a >= 1.0f);
+                if (hasTexture) {
+                    auto& pipeline = pipelineCandidate.value();
                     auto& texture = backgroundTextureCandidate.value();
                     GPU::BindPipeline(pipeline);
                     GPU::SetShaderUniform(pipeline.fragment, "uColor", backgroundColor);
                     GPU::SetShaderUniform(pipeline.fragment, "uResolution", requiredResolution);
                     GPU::BindTextureToShader(pipeline.fragment, "uTexture", texture, 0);
                     GPU::DrawArrays(3);
+                    RenderTargetPool::Consume(texture);
                 }
                 TryAppendAbstractPinMap(result, "Value", framebuffer);
             }
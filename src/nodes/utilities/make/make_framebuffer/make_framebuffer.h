@@ -2,12 +2,14 @@
 #include "raster.h"
 #include "common/common.h"
 #include "gpu/gpu.h"
+#include "gpu/shader_compiler.h"
 #include "compositor/compositor.h"
+#include "compositor/render_target_pool.h"
+#include "compositor/content_bounds.h"
 
 namespace Raster {
     struct MakeFramebuffer : public NodeBase {
         MakeFramebuffer();
-        ~MakeFramebuffer();
         
         AbstractPinMap AbstractExecute(AbstractPinMap t_accumulator = {});
         void AbstractRenderProperties();
@@ -23,6 +25,6 @@ namespace Raster {
         private:
         std::optional<Framebuffer> m_internalFramebuffer;
 
-        static std::optional<Pipeline> s_pipeline;
+        static PendingPipeline s_pipeline;
     };
 };
\ No newline at end of file
@@ -111,6 +111,7 @@ namespace Raster {
                 std::string pathExtension = GetExtension(path.get());
                 pathExtension = ReplaceString(pathExtension, "\\.", "");
                 for (auto& implementation : Assets::s_implementations) {
+                    if (targetAssetPackageName.has_value() && targetAssetPackageName.value() != implementation.description.packageName) continue;
                     auto& extensions = implementation.description.extensions;
                     if (std::find(extensions.begin(), extensions.end(), pathExtension) != extensions.end()) {
                         assetPackageNameCandidate = implementation.description.packageName;
@@ -176,7 +177,7 @@ namespace Raster {
                     auto assetCandidate = Workspace::GetAssetByAssetID(selectedAssets[0]);
                     if (assetCandidate.has_value()) {
                         auto& asset = assetCandidate.value();
-                        auto textureCandidate = asset->GetPreviewTexture();
+                        auto textureCandidate = asset->GetThumbnailTexture();
                         if (textureCandidate.has_value()) {
                             auto& texture = textureCandidate.value();
                             auto fitSize = FitRectInRect(assetPreviewSize, ImVec2(texture.width, texture.height));
@@ -189,7 +190,10 @@ namespace Raster {
                                 ImGui::OpenPopup("##assetPreviewTextureMaximized");
                             }
                             if (ImGui::BeginPopup("##assetPreviewTextureMaximized")) {
-                                ImGui::Image((ImTextureID) texture.handle, FitRectInRect(ImGui::GetWindowViewport()->Size, ImVec2(texture.width, texture.height)) / 2);
+                                // full resolution is only requested once the preview is actually maximized
+                                auto fullTextureCandidate = asset->GetPreviewTexture();
+                                auto& fullTexture = fullTextureCandidate.has_value() ? fullTextureCandidate.value() : texture;
+                                ImGui::Image((ImTextureID) fullTexture.handle, FitRectInRect(ImGui::GetWindowViewport()->Size, ImVec2(fullTexture.width, fullTexture.height)) / 2);
                                 ImGui::EndPopup();
                             }
                         }
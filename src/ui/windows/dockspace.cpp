@@ -1,4 +1,7 @@
 #include "dockspace.h"
+#include "compositor/tiled_renderer.h"
+#include "gpu/shader_compiler.h"
+#include "gpu/texture_residency.h"
 
 namespace Raster {
 
@@ -79,6 +82,22 @@ namespace Raster {
                     auto& project = Workspace::GetProject();
                     WriteFile(project.path + "/project.json", project.Serialize().dump());
                 }
+                if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_IMAGE, Localization::GetString("RENDER_FRAME").c_str()).c_str(), nullptr, nullptr, Workspace::IsProjectLoaded())) {
+                    NFD::UniquePath path;
+                    nfdwindowhandle_t window;
+                    GPU::GetNFDWindowHandle(&window);
+                    nfdfilteritem_t filters[] = {{"TIFF", "tif,tiff"}, {"OpenEXR", "exr"}, {"PNG", "png"}};
+                    nfdresult_t result = NFD::SaveDialog(path, filters, 3, nullptr, "render.tif", window);
+                    if (result == NFD_OKAY) {
+                        auto& project = Workspace::GetProject();
+                        // preferredResolution isn't limited by the GPU here, the frame is rendered in tiles
+                        TiledRenderer::Request(TiledRenderRequest{
+                            .path = path.get(),
+                            .resolution = glm::ivec2(project.preferredResolution),
+                            .tileSize = 4096
+                        });
+                    }
+                }
                 ImGui::Separator();
                 if (ImGui::MenuItem(FormatString("%s %s", ICON_FA_XMARK, Localization::GetString("EXIT_RASTER").c_str()).c_str())) {
                     std::exit(0);
@@ -90,6 +109,38 @@ namespace Raster {
             ImVec2 rightAlignedTextSize = ImGui::CalcTextSize(rightAlignedText.c_str());
             ImGui::SetCursorPosX(ImGui::GetWindowSize().x - rightAlignedTextSize.x - ImGui::GetStyle().WindowPadding.x);
             ImGui::Text("%s", rightAlignedText.c_str());
+            if (ImGui::BeginItemTooltip()) {
+                auto statistics = GPU::GetFrameStatistics();
+                ImGui::Text("%s: %i", Localization::GetString("DRAW_CALLS").c_str(), statistics.drawCalls);
+                ImGui::Text("%s: %i", Localization::GetString("COMPUTE_DISPATCHES").c_str(), statistics.computeDispatches);
+                ImGui::Text("%s: %i", Localization::GetString("CLEARS").c_str(), statistics.clears);
+                ImGui::Text("%s: %i", Localization::GetString("FRAMEBUFFER_BINDS").c_str(), statistics.framebufferBinds);
+                ImGui::Text("%s: %i", Localization::GetString("PIPELINE_BINDS").c_str(), statistics.pipelineBinds);
+                ImGui::Text("%s: %i", Localization::GetString("TEXTURE_BINDS").c_str(), statistics.textureBinds);
+                ImGui::Text("%s: %i", Localization::GetString("SAMPLER_BINDS").c_str(), statistics.samplerBinds);
+                ImGui::Text("%s: %i", Localization::GetString("STATE_CHANGES").c_str(), statistics.stateChanges);
+                ImGui::Text("%s: %i", Localization::GetString("SKIPPED_CALLS").c_str(), statistics.skippedCalls);
+                ImGui::Text("%s: %i", Localization::GetString("COMPILING_SHADERS").c_str(), ShaderCompiler::GetPendingCount());
+                ImGui::Separator();
+                auto counters = GPU::GetObjectCounters();
+                ImGui::Text("%s: %i", Localization::GetString("LIVE_TEXTURES").c_str(), counters.textures);
+                ImGui::Text("%s: %i", Localization::GetString("LIVE_FRAMEBUFFERS").c_str(), counters.framebuffers);
+                ImGui::Text("%s: %i", Localization::GetString("LIVE_SAMPLERS").c_str(), counters.samplers);
+                ImGui::Text("%s: %i", Localization::GetString("LIVE_SHADERS").c_str(), counters.shaders);
+                ImGui::Text("%s: %i", Localization::GetString("LIVE_PIPELINES").c_str(), counters.pipelines);
+                ImGui::Text("%s: %i", Localization::GetString("PENDING_DESTRUCTIONS").c_str(), counters.pendingDestructions);
+                ImGui::Separator();
+                auto memoryUsage = GPU::GetMemoryUsage();
+                // indexed by GPUMemoryOwner
+                static std::vector<std::string> s_memoryOwnerKeys = {"VRAM_OTHER", "VRAM_COMPOSITOR", "VRAM_NODES", "VRAM_ASSETS"};
+                for (int i = 0; i < GPU_MEMORY_OWNERS_COUNT; i++) {
+                    ImGui::Text("%s: %0.1f MB", Localization::GetString(s_memoryOwnerKeys[i]).c_str(), memoryUsage.bytes[i] / (1024.0f * 1024.0f));
+                }
+                ImGui::Text("%s: %0.1f / %i MB", Localization::GetString("VRAM_TOTAL").c_str(), memoryUsage.total / (1024.0f * 1024.0f), Workspace::s_configuration.vramBudget);
+                ImGui::Text("%s: %i (%0.1f MB)", Localization::GetString("RESIDENT_ASSET_TEXTURES").c_str(), TextureResidency::GetResidentCount(), TextureResidency::GetResidentMemory() / (1024.0f * 1024.0f));
+                ImGui::Text("%s: %i", Localization::GetString("EVICTED_ASSET_TEXTURES").c_str(), TextureResidency::GetEvictedCount());
+                ImGui::EndTooltip();
+            }
             ImGui::EndMainMenuBar();
         }
 
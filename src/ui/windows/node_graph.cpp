@@ -4,6 +4,7 @@
 #include "common/dispatchers.h"
 #include "timeline.h"
 #include "asset_manager.h"
+#include "compositor/render_target_pool.h"
 
 namespace Raster {
 
@@ -1293,6 +1294,7 @@ namespace Raster {
 
 
             if (s_outerTooltip.has_value()) {
+                RenderTargetPool::PreserveIntermediates();
                 if (ImGui::BeginTooltip()) {
                     auto value = s_outerTooltip.value();
                     ImGui::Text("%s %s: %s", ICON_FA_CIRCLE_INFO, Localization::GetString("VALUE_TYPE").c_str(), Workspace::GetTypeName(value).c_str());
@@ -245,6 +245,26 @@ namespace Raster {
                             if (ImGui::Button(FormatString("%s %s", node->bypassed ? ICON_FA_CHECK : ICON_FA_XMARK, Localization::GetString("BYPASSED").c_str()).c_str())) {
                                 node->bypassed = !node->bypassed;
                             }
+                            ImGui::SameLine();
+                            static std::vector<std::pair<float, std::string>> s_resolutionScales = {
+                                {1.0f, "1"}, {0.5f, "1/2"}, {0.25f, "1/4"}
+                            };
+                            std::string resolutionScaleText = "1";
+                            for (auto& scale : s_resolutionScales) {
+                                if (node->resolutionScale == scale.first) resolutionScaleText = scale.second;
+                            }
+                            if (ImGui::Button(FormatString("%s %s: %s", ICON_FA_EXPAND, Localization::GetString("RESOLUTION_SCALE").c_str(), resolutionScaleText.c_str()).c_str())) {
+                                ImGui::OpenPopup("##resolutionScalePopup");
+                            }
+                            if (ImGui::BeginPopup("##resolutionScalePopup")) {
+                                ImGui::SeparatorText(FormatString("%s %s", ICON_FA_EXPAND, Localization::GetString("RESOLUTION_SCALE").c_str()).c_str());
+                                for (auto& scale : s_resolutionScales) {
+                                    if (ImGui::MenuItem(scale.second.c_str(), nullptr, node->resolutionScale == scale.first)) {
+                                        node->resolutionScale = scale.first;
+                                    }
+                                }
+                                ImGui::EndPopup();
+                            }
                             if (treeExpanded) {
                                 node->AbstractRenderProperties();
                                 ImGui::TreePop();
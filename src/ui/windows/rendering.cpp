@@ -1,6 +1,7 @@
 #include "rendering.h"
 #include "font/font.h"
 #include "compositor/compositor.h"
+#include "compositor/render_target_pool.h"
 #include "common/transform2d.h"
 #include "common/dispatchers.h"
 
@@ -122,6 +123,14 @@ namespace Raster {
                     else if (previewResolutionScale == 0.3f) previewResolutionName = Localization::GetString("THIRD");
                     else if (previewResolutionScale == 0.2f) previewResolutionName = Localization::GetString("QUARTER");
 
+                    if (!project.customData.contains("AdaptivePreviewResolution")) {
+                        project.customData["AdaptivePreviewResolution"] = false;
+                    }
+                    bool adaptiveResolution = project.customData["AdaptivePreviewResolution"];
+                    if (adaptiveResolution && Compositor::s_adaptiveResolutionScale < previewResolutionScale) {
+                        previewResolutionName += FormatString(" (%s %i%%)", ICON_FA_GAUGE, (int) (Compositor::s_adaptiveResolutionScale * 100));
+                    }
+
                     if (ImGui::MenuItem(FormatString("%s %s: %s", ICON_FA_IMAGE, Localization::GetString("PREVIEW_RESOLUTION").c_str(), previewResolutionName.c_str()).c_str())) {
                         ImGui::OpenPopup("##previewResolutionPresets");
                     }
@@ -144,6 +153,8 @@ namespace Raster {
                             ImGui::SliderFloat("##customResolution", &previewResolutionScale, 0.1f, 1.0f, "%0.2f");
                             ImGui::EndMenu();
                         }
+                        ImGui::Separator();
+                        ImGui::MenuItem(FormatString("%s %s", ICON_FA_GAUGE, Localization::GetString("ADAPTIVE_RESOLUTION").c_str()).c_str(), nullptr, &adaptiveResolution);
                         ImGui::EndPopup();
                     }
                     ImGui::Separator();
@@ -151,6 +162,8 @@ namespace Raster {
                     project.customData["PreviewResolutionScale"] = previewResolutionScale;
 
                     Compositor::previewResolutionScale = previewResolutionScale;
+                    project.customData["AdaptivePreviewResolution"] = adaptiveResolution;
+                    Compositor::s_adaptiveResolution = adaptiveResolution;
 
                     int attributesCount = 0;
                     int selectedAttributeIndex = 0;
@@ -223,6 +236,10 @@ namespace Raster {
                         }
                     }
                     if (dispatcherTarget.has_value()) {
+                        RenderTargetPool::PreserveIntermediates();
+                        if (Dispatchers::s_previewAttachment > 0) {
+                            RenderTargetPool::RequireUVAttachments();
+                        }
                         auto& value = dispatcherTarget.value();
                         for (auto& dispatcher : Dispatchers::s_previewDispatchers) {
                             if (dispatcher.first == std::type_index(value.type())) {
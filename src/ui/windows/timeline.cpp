@@ -817,13 +817,7 @@ namespace Raster {
                             auto& primaryFramebuffer = Compositor::primaryFramebuffer.value();
                             auto requiredResolution = Compositor::GetRequiredResolution();
                             static Framebuffer previewFramebuffer = Compositor::GenerateCompatibleFramebuffer(requiredResolution);
-                            if (previewFramebuffer.width != requiredResolution.x || previewFramebuffer.height != requiredResolution.y) {
-                                for (auto& attachment : previewFramebuffer.attachments) {
-                                    GPU::DestroyTexture(attachment);
-                                }
-                                GPU::DestroyFramebuffer(previewFramebuffer);
-                                previewFramebuffer = Compositor::GenerateCompatibleFramebuffer(requiredResolution);
-                            }
+                            Compositor::EnsureResolutionConstraintsForFramebuffer(previewFramebuffer);
                             GPU::BindFramebuffer(previewFramebuffer);
                             GPU::ClearFramebuffer(project.backgroundColor.r, project.backgroundColor.g, project.backgroundColor.b, project.backgroundColor.a);
                             int compositionIndex = 0;